@@ -0,0 +1,114 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Row sweep y(i,j) += alpha * x(i,j) over layout_right matrices,
+// comparing accessor_basic on aligned and misaligned data with
+// aligned_accessor, which lets the compiler use aligned vector loads.
+//
+// Usage: aligned_accessor_benchmark [rows] [repeats]
+
+#include <experimental/mdspan>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#else
+#define BENCHMARK_NOINLINE
+#endif
+
+using namespace std::experimental::fundamentals_v3;
+
+constexpr size_t byte_alignment = 64;
+constexpr ptrdiff_t columns = 1024;
+
+using matrix_extents = extents<dynamic_extent,columns>;
+
+template<class Accessor>
+using matrix = basic_mdspan<float,matrix_extents,layout_right,Accessor>;
+
+template<class Accessor>
+BENCHMARK_NOINLINE
+void axpy_rows(float alpha, matrix<Accessor> x, matrix<Accessor> y) {
+  for(ptrdiff_t i = 0; i < y.extent(0); i++)
+    for(ptrdiff_t j = 0; j < columns; j++)
+      y(i,j) += alpha * x(i,j);
+}
+
+template<class Accessor>
+double time_axpy_rows(float* x_data, float* y_data, ptrdiff_t rows, int repeats) {
+  matrix<accessor_basic<float>> x_basic(x_data,rows), y_basic(y_data,rows);
+  matrix<Accessor> x(x_basic), y(y_basic);
+  axpy_rows(1.0f,x,y);
+  auto begin = std::chrono::steady_clock::now();
+  for(int r = 0; r < repeats; r++)
+    axpy_rows(1.0f/float(r+1),x,y);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end-begin).count() / repeats;
+}
+
+struct free_deleter { void operator()(float* p) const { std::free(p); } };
+
+int main(int argc, char* argv[]) {
+  const ptrdiff_t rows = argc > 1 ? std::atol(argv[1]) : 256;
+  const int repeats = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  // One extra row so the misaligned views stay in bounds.
+  const size_t bytes = size_t(rows+1) * columns * sizeof(float);
+  std::unique_ptr<float,free_deleter> x( static_cast<float*>( std::aligned_alloc(byte_alignment,bytes) ) );
+  std::unique_ptr<float,free_deleter> y( static_cast<float*>( std::aligned_alloc(byte_alignment,bytes) ) );
+  for(size_t i = 0; i < bytes/sizeof(float); i++) { x.get()[i] = 1.0f; y.get()[i] = 0.0f; }
+
+  const double aligned   = time_axpy_rows<aligned_accessor<float,byte_alignment>>(x.get(),y.get(),rows,repeats);
+  const double basic     = time_axpy_rows<accessor_basic<float>>(x.get(),y.get(),rows,repeats);
+  const double unaligned = time_axpy_rows<accessor_basic<float>>(x.get()+1,y.get()+1,rows,repeats);
+
+  const double gbytes = 3.0 * rows * columns * sizeof(float) * 1e-9;
+  std::printf("rows %ld columns %ld repeats %d\n", long(rows), long(columns), repeats);
+  std::printf("aligned_accessor            %10.3f us %8.2f GB/s\n", aligned*1e6, gbytes/aligned);
+  std::printf("accessor_basic, aligned     %10.3f us %8.2f GB/s\n", basic*1e6, gbytes/basic);
+  std::printf("accessor_basic, misaligned  %10.3f us %8.2f GB/s\n", unaligned*1e6, gbytes/unaligned);
+  return 0;
+}
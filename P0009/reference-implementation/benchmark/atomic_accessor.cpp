@@ -0,0 +1,143 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Scatter-add counts(b,k) += 1 from several threads through the
+// atomic accessors, comparing memory orders, and through a striped_reducer
+// with one stripe per thread. In the contended case all threads update the
+// same row of bins, in the uncontended case each thread owns a row padded
+// to its own cache lines.
+//
+// On x86-64 every RMW is a locked instruction regardless of the order, so
+// the orders only differ on weakly ordered targets such as ARM, where
+// seq_cst and acq_rel add barriers around each update.
+//
+// Usage: atomic_accessor_benchmark [threads] [updates per thread]
+
+#include <experimental/atomic_accessor>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#else
+#define BENCHMARK_NOINLINE
+#endif
+
+using namespace std::experimental::fundamentals_v3;
+
+// 16 bins of 4 bytes fill one 64 byte cache line
+constexpr ptrdiff_t bins = 16;
+
+using counts_extents = extents<dynamic_extent,bins>;
+
+template<class Accessor>
+using counts = basic_mdspan<int,counts_extents,layout_right,Accessor>;
+
+template<class Accessor>
+BENCHMARK_NOINLINE
+void scatter_add(counts<Accessor> c, ptrdiff_t row, long updates) {
+  for(long i = 0; i < updates; i++)
+    c(row,(i*7)%bins) += 1;
+}
+
+template<class Accessor>
+double time_scatter_add(counts<Accessor> c, int threads, long updates, bool contended) {
+  std::vector<std::thread> pool;
+  auto begin = std::chrono::steady_clock::now();
+  for(int t = 0; t < threads; t++)
+    pool.emplace_back(scatter_add<Accessor>,c,contended ? 0 : t,updates);
+  for(auto& thread : pool)
+    thread.join();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end-begin).count();
+}
+
+// Includes flushing the stripes into the destination.
+double time_striped_scatter_add(int* data, int threads, long updates, bool contended) {
+  auto begin = std::chrono::steady_clock::now();
+  const counts_extents e(threads);
+  const layout_right::mapping<counts_extents> mapping(e);
+  striped_reducer<int,counts_extents> reducer(mapping,size_t(threads));
+  time_scatter_add(reducer.view(),threads,updates,contended);
+  reducer.flush(counts<accessor_basic<int>>(data,threads));
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end-begin).count();
+}
+
+void print(const char* name, double contended, double uncontended, int threads, long updates) {
+  const double total = double(threads) * updates;
+  std::printf("%-24s %10.2f %10.2f\n", name, total/contended*1e-6, total/uncontended*1e-6);
+}
+
+template<class Accessor>
+void report(const char* name, int* data, int threads, long updates) {
+  counts<Accessor> c(counts<accessor_basic<int>>(data,threads));
+  print(name,
+        time_scatter_add<Accessor>(c,threads,updates,true),
+        time_scatter_add<Accessor>(c,threads,updates,false),
+        threads,updates);
+}
+
+int main(int argc, char* argv[]) {
+  const int threads = argc > 1 ? std::atoi(argv[1]) : int(std::thread::hardware_concurrency());
+  const long updates = argc > 2 ? std::atol(argv[2]) : 10000000;
+
+  // Rows of one cache line each, aligned so that rows do not share lines.
+  struct alignas(64) row { int bin[bins]; };
+  std::vector<row> data(threads);
+  int* ptr = &data[0].bin[0];
+
+  std::printf("threads %d updates per thread %ld\n", threads, updates);
+  std::printf("%-24s %10s %10s\n", "Mupdates/s", "contended", "private");
+  report<atomic_accessor_relaxed<int>>("atomic_accessor_relaxed", ptr, threads, updates);
+  report<atomic_accessor_acq_rel<int>>("atomic_accessor_acq_rel", ptr, threads, updates);
+  report<atomic_accessor_seq_cst<int>>("atomic_accessor_seq_cst", ptr, threads, updates);
+  print("striped_reducer",
+        time_striped_scatter_add(ptr, threads, updates, true),
+        time_striped_scatter_add(ptr, threads, updates, false),
+        threads, updates);
+  return 0;
+}
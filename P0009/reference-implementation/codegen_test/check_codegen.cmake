@@ -0,0 +1,25 @@
+# Usage: cmake -DASM_FILE=<file.s> -P check_codegen.cmake
+#
+# Fails if any function whose name starts with codegen_ contains a call or
+# a branch instruction.
+
+file(STRINGS ${ASM_FILE} lines)
+
+set(current "")
+set(failures "")
+foreach(line IN LISTS lines)
+  if(line MATCHES "^(codegen_[A-Za-z0-9_]+):")
+    set(current ${CMAKE_MATCH_1})
+  elseif(line MATCHES "^[A-Za-z_.][A-Za-z0-9_.$]*:")
+    if(NOT line MATCHES "^\\.L")
+      set(current "")
+    endif()
+  elseif(current AND line MATCHES "^[ \t]+(call|jmp|j[a-z]+)[ \t]")
+    list(APPEND failures "${current}: ${line}")
+  endif()
+endforeach()
+
+if(failures)
+  string(REPLACE ";" "\n" failures "${failures}")
+  message(FATAL_ERROR "Index mapping did not reduce to a multiply-add chain:\n${failures}")
+endif()
@@ -0,0 +1,84 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Compiled to assembly by CMakeLists.txt and checked by check_codegen.cmake:
+// every codegen_* function must reduce to a straight multiply-add chain,
+// i.e. contain no call and no branch.
+
+#include<experimental/mdspan>
+
+using namespace std::experimental::fundamentals_v3;
+
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> extents_dyn_3d;
+typedef extents<8,dynamic_extent,4> extents_mixed_3d;
+
+extern "C" {
+
+ptrdiff_t codegen_layout_right_dynamic(const layout_right::mapping<extents_dyn_3d>& m,
+                                       ptrdiff_t i, ptrdiff_t j, ptrdiff_t k) {
+  return m(i,j,k);
+}
+
+ptrdiff_t codegen_layout_left_dynamic(const layout_left::mapping<extents_dyn_3d>& m,
+                                      ptrdiff_t i, ptrdiff_t j, ptrdiff_t k) {
+  return m(i,j,k);
+}
+
+ptrdiff_t codegen_layout_right_mixed(const layout_right::mapping<extents_mixed_3d>& m,
+                                     ptrdiff_t i, ptrdiff_t j, ptrdiff_t k) {
+  return m(i,j,k);
+}
+
+ptrdiff_t codegen_layout_left_mixed(const layout_left::mapping<extents_mixed_3d>& m,
+                                    ptrdiff_t i, ptrdiff_t j, ptrdiff_t k) {
+  return m(i,j,k);
+}
+
+// 7-point stencil inner access on a layout_right grid
+double codegen_stencil_right(const basic_mdspan<double,extents_dyn_3d,layout_right>& u,
+                             ptrdiff_t i, ptrdiff_t j, ptrdiff_t k) {
+  return u(i-1,j,k) + u(i+1,j,k) + u(i,j-1,k) + u(i,j+1,k)
+       + u(i,j,k-1) + u(i,j,k+1) - 6.0*u(i,j,k);
+}
+
+}
@@ -41,38 +41,77 @@
 // ************************************************************************
 //@HEADER
 
+#include <cstddef> // std::ptrdiff_t
+#include <cstdint> // std::uintptr_t
+#include <atomic> // std::memory_order
 #include <type_traits>
 
-template<class T>
-class atomic_ref {};
+// atomic_ref reference implementation of P0019, see MDSPAN_ATOMIC_REF_INCLUDE_DIR
+#include <atomic_ref.hpp>
 
-template<class T>
-struct accessor_atomic {
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
 
-  static_assert( std::is_trivially_copyable<T>::value );
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
 
-	using element_type = T;
-	using reference    = atomic_ref<T> ;
-	using pointer      = T*;
-	using offset       = accessor_atomic ;
+namespace detail {
 
-  constexpr accessor_atomic() noexcept = default ;
-  constexpr accessor_atomic( accessor_atomic && ) noexcept = default ;
-  constexpr accessor_atomic( const accessor_atomic & ) noexcept = default ;
-  accessor_atomic & operator =( accessor_atomic && ) noexcept = default ;
-  accessor_atomic & operator =( const accessor_atomic & ) noexcept = default ;
+// [mdspan.accessor.atomic.basic]
+// Accessor whose reference is an atomic_ref-like ReferenceType bound to
+// the element, so that every element access of a basic_mdspan is atomic.
+template<class ElementType, class ReferenceType>
+class basic_atomic_accessor {
+public:
 
-  explicit constexpr accessor_atomic( pointer other ) noexcept
-	  : ptr(other)
-		{ assert( 0 == reinterpret_cast<uintptr_t>(ptr) % reference::required_alignment ); };
+  static_assert( is_trivially_copyable<ElementType>::value , "basic_atomic_accessor: ElementType must be trivially copyable" );
 
-  constexpr reference operator[]( size_t i ) const noexcept
-	  { return reference( ptr[i] ); }
+  using element_type  = ElementType;
+  using pointer       = ElementType*;
+  using offset_policy = basic_atomic_accessor;
+  using reference     = ReferenceType;
 
-  constexpr offset operator+( size_t i ) const noexcept
-	  { return offset(ptr+i); }
+  constexpr basic_atomic_accessor() noexcept = default;
 
-  constexpr operator pointer() const
-	  { assert(false /* cannot access raw data outside of atomic */); }
+  template<class OtherElementType,
+           typename enable_if<is_convertible<OtherElementType(*)[],element_type(*)[]>::value,int>::type = 0>
+  constexpr basic_atomic_accessor( accessor_basic<OtherElementType> ) noexcept {}
+
+  constexpr typename offset_policy::pointer
+    offset( pointer p , ptrdiff_t i ) const noexcept
+      { return typename offset_policy::pointer(p+i); }
+
+  reference access( pointer p , ptrdiff_t i ) const noexcept
+    { return reference( p[i] ); }
+
+  constexpr ElementType* decay( pointer p ) const noexcept
+    { return p; }
+
+  // Checked by basic_mdspan on construction; every element satisfies the
+  // alignment requirement of the reference if the first one does.
+  static bool is_sufficiently_aligned( pointer p ) noexcept
+    { return 0 == reinterpret_cast<uintptr_t>(p) % reference::required_alignment; }
 };
 
+} // namespace detail
+
+// [mdspan.accessor.atomic.bounded]
+template<class ElementType>
+using atomic_accessor = detail::basic_atomic_accessor<ElementType,Foo::atomic_ref<ElementType>>;
+
+// Every access, including the compound assignment operators of the
+// reference, uses MemoryOrder.
+template<class ElementType, memory_order MemoryOrder>
+using atomic_accessor_bound = detail::basic_atomic_accessor<ElementType,Foo::atomic_ref_bound<ElementType,MemoryOrder>>;
+
+template<class ElementType>
+using atomic_accessor_relaxed = atomic_accessor_bound<ElementType,memory_order_relaxed>;
+
+template<class ElementType>
+using atomic_accessor_acq_rel = atomic_accessor_bound<ElementType,memory_order_acq_rel>;
+
+template<class ElementType>
+using atomic_accessor_seq_cst = atomic_accessor_bound<ElementType,memory_order_seq_cst>;
+
+}}} // std::experimental::fundamentals_v3
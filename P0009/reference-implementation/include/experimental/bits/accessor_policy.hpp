@@ -41,6 +41,10 @@
 // ************************************************************************
 //@HEADER
 
+#include <cstddef> // std::ptrdiff_t
+#include <cstdint> // std::uintptr_t
+#include <memory> // std::assume_aligned
+
 //--------------------------------------------------------------------------
 //--------------------------------------------------------------------------
 
@@ -72,4 +76,89 @@ public:
     { return p; }
 };
 
+namespace detail {
+
+  template<size_t ByteAlignment, class ElementType>
+  constexpr ElementType* assume_aligned( ElementType* p ) noexcept {
+#if defined( __cpp_lib_assume_aligned )
+    return std::assume_aligned<ByteAlignment>( p );
+#elif defined( __GNUC__ ) || defined( __clang__ )
+    return static_cast<ElementType*>( __builtin_assume_aligned( p , ByteAlignment ) );
+#else
+    return p;
+#endif
+  }
+
+} // namespace detail
+
+// [mdspan.accessor.aligned]
+// accessor_basic whose pointer is aligned to ByteAlignment bytes,
+// which lets the compiler use aligned vector loads and stores.
+template<class ElementType, size_t ByteAlignment>
+class aligned_accessor {
+public:
+
+  static_assert( ( ByteAlignment & ( ByteAlignment - 1 ) ) == 0 , "aligned_accessor: ByteAlignment must be a power of two" );
+  static_assert( ByteAlignment >= alignof(ElementType) , "aligned_accessor: ByteAlignment must be at least alignof(ElementType)" );
+
+  using element_type  = ElementType;
+  using pointer       = ElementType*;
+  using offset_policy = accessor_basic<ElementType>;
+  using reference     = ElementType&;
+
+  static constexpr size_t byte_alignment = ByteAlignment;
+
+  constexpr aligned_accessor() noexcept = default;
+
+  template<class OtherElementType, size_t OtherByteAlignment,
+           typename enable_if<is_convertible<OtherElementType(*)[],element_type(*)[]>::value &&
+                              OtherByteAlignment % ByteAlignment == 0,int>::type = 0>
+  constexpr aligned_accessor( aligned_accessor<OtherElementType,OtherByteAlignment> ) noexcept {}
+
+  // Explicit since the pointer must be sufficiently aligned, which
+  // basic_mdspan checks when converting from an accessor_basic mdspan.
+  template<class OtherElementType,
+           typename enable_if<is_convertible<OtherElementType(*)[],element_type(*)[]>::value,int>::type = 0>
+  explicit constexpr aligned_accessor( accessor_basic<OtherElementType> ) noexcept {}
+
+  constexpr operator accessor_basic<element_type>() const noexcept
+    { return accessor_basic<element_type>(); }
+
+  // p+i is only aligned for some i, hence the offset_policy
+  constexpr typename offset_policy::pointer
+    offset( pointer p , ptrdiff_t i ) const noexcept
+      { return typename offset_policy::pointer(p+i); }
+
+  constexpr reference access( pointer p , ptrdiff_t i ) const noexcept
+    { return detail::assume_aligned<byte_alignment>( p )[i]; }
+
+  constexpr ElementType* decay( pointer p ) const noexcept
+    { return detail::assume_aligned<byte_alignment>( p ); }
+
+  static bool is_sufficiently_aligned( pointer p ) noexcept
+    { return 0 == reinterpret_cast<uintptr_t>(p) % byte_alignment; }
+};
+
+namespace detail {
+
+  // Accessors with an alignment requirement on the data handle provide a
+  // static is_sufficiently_aligned. This is found through the accessor type
+  // on instantiation, so accessors declared after basic_mdspan are checked
+  // as well.
+  template<class Accessor, class Pointer>
+  constexpr auto is_valid_data_handle_impl( Pointer p , int ) noexcept
+    -> decltype( Accessor::is_sufficiently_aligned( p ) , bool() )
+    { return p == nullptr || Accessor::is_sufficiently_aligned( p ); }
+
+  template<class Accessor, class Pointer>
+  constexpr bool is_valid_data_handle_impl( Pointer , long ) noexcept
+    { return true; }
+
+  // Precondition check of a data handle on basic_mdspan construction.
+  template<class Accessor, class Pointer>
+  constexpr bool is_valid_data_handle( const Accessor & , Pointer p ) noexcept
+    { return is_valid_data_handle_impl<Accessor>( p , 0 ); }
+
+} // namespace detail
+
 }}} // std::experimental::fundamentals_v3
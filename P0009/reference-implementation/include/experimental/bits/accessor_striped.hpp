@@ -0,0 +1,227 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <cassert>
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <cstdint> // std::uintptr_t
+#include <atomic>
+#include <thread> // std::thread::hardware_concurrency
+#include <type_traits>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+namespace detail {
+
+// Stripes are padded to whole cache lines so that threads updating
+// different stripes never share a line.
+constexpr size_t striped_cache_line = 64;
+
+// Small dense index of the calling thread, assigned on first use.
+inline size_t this_thread_stripe_index() noexcept {
+  static atomic<size_t> next_index( 0 );
+  thread_local const size_t index = next_index.fetch_add( 1 , memory_order_relaxed );
+  return index;
+}
+
+constexpr size_t round_up_to_power_of_two( size_t n ) noexcept {
+  size_t p = 1;
+  while( p < n ) p *= 2;
+  return p;
+}
+
+} // namespace detail
+
+// [mdspan.accessor.striped]
+// Accessor over a striped_reducer: every thread updates the copy (stripe)
+// of the array selected by its thread index, with relaxed atomic_ref
+// operations since threads may share a stripe. The pointer designates the
+// element in stripe 0, the other stripes follow at stripe_stride elements.
+template<class ElementType>
+class striped_accessor {
+public:
+  using element_type  = ElementType;
+  using pointer       = ElementType*;
+  using offset_policy = striped_accessor;
+  using reference     = Foo::atomic_ref_relaxed<ElementType>;
+
+  // A single stripe, i.e. atomic_accessor_relaxed
+  constexpr striped_accessor() noexcept = default;
+
+  // Requires stripes to be a power of two
+  constexpr striped_accessor( size_t stripes , ptrdiff_t stripe_stride ) noexcept
+    : stripe_mask_( stripes - 1 ), stripe_stride_( stripe_stride ) {}
+
+  constexpr typename offset_policy::pointer
+    offset( pointer p , ptrdiff_t i ) const noexcept
+      { return typename offset_policy::pointer(p+i); }
+
+  reference access( pointer p , ptrdiff_t i ) const noexcept
+    { return reference( p[ i + stripe_stride_ * ptrdiff_t( detail::this_thread_stripe_index() & stripe_mask_ ) ] ); }
+
+  constexpr ElementType* decay( pointer p ) const noexcept
+    { return p; }
+
+  constexpr size_t stripes() const noexcept { return stripe_mask_ + 1; }
+
+  constexpr ptrdiff_t stripe_stride() const noexcept { return stripe_stride_; }
+
+private:
+  size_t stripe_mask_ = 0;
+  ptrdiff_t stripe_stride_ = 0;
+};
+
+// [mdspan.reducer.striped]
+// Owns stripes copies of an array of zero initialized elements. view()
+// is a basic_mdspan to update them concurrently like an atomic_accessor
+// mdspan, e.g. view()(i,j) += x, and flush() adds the sum of all copies
+// into a destination array and resets the copies to zero. flush() must not
+// run concurrently with updates through view().
+template<class ElementType, class Extents, class LayoutPolicy = layout_right>
+class striped_reducer {
+public:
+
+  using extents_type  = Extents;
+  using layout_type   = LayoutPolicy;
+  using mapping_type  = typename layout_type::template mapping<extents_type>;
+  using element_type  = ElementType;
+  using accessor_type = striped_accessor<element_type>;
+  using mdspan_type   = basic_mdspan<element_type,extents_type,layout_type,accessor_type>;
+
+  static_assert( mapping_type::is_always_contiguous() , "striped_reducer: LayoutPolicy must be contiguous" );
+
+  template<class... IndexType ,
+           typename enable_if<( sizeof...(IndexType) > 0 ) &&
+                              ( is_convertible<IndexType,typename extents_type::index_type>::value && ... ),int>::type = 0 >
+  explicit striped_reducer( IndexType ... DynamicExtents )
+    : striped_reducer( mapping_type( extents_type( DynamicExtents... ) ) ) {}
+
+  // stripes is rounded up to a power of two and defaults to the number
+  // of hardware threads
+  explicit striped_reducer( const mapping_type & m , size_t stripes = default_stripes() )
+    : map_( m )
+    , stripes_( detail::round_up_to_power_of_two( stripes ) )
+    , stripe_stride_( padded_stride( m.required_span_size() ) )
+    , c_( stripes_ * size_t( stripe_stride_ ) + padding_elements )
+    , data_( aligned_data( c_.data() ) )
+    {}
+
+  striped_reducer( striped_reducer && ) = default;
+  striped_reducer & operator = ( striped_reducer && ) = default;
+
+  striped_reducer( const striped_reducer & ) = delete;
+  striped_reducer & operator = ( const striped_reducer & ) = delete;
+
+  mdspan_type view() noexcept
+    { return mdspan_type( data_ , map_ , accessor_type( stripes_ , stripe_stride_ ) ); }
+
+  // Combines the stripes with a pairwise tree of contiguous, vectorizable
+  // additions and then adds stripe 0 into dst.
+  template<class OtherAccessor>
+  void flush( const basic_mdspan<element_type,extents_type,layout_type,OtherAccessor> & dst ) {
+    assert( dst.extents() == map_.extents() );
+    const ptrdiff_t n = map_.required_span_size();
+
+    for( size_t step = 1 ; step < stripes_ ; step *= 2 )
+      for( size_t s = 0 ; s + step < stripes_ ; s += 2 * step )
+        combine( stripe( s ) , stripe( s + step ) , n );
+
+    element_type * const sum = stripe( 0 );
+    const OtherAccessor acc = dst.accessor();
+    for( ptrdiff_t i = 0 ; i < n ; i++ ) {
+      acc.access( dst.data() , i ) += sum[i];
+      sum[i] = element_type();
+    }
+  }
+
+  constexpr const extents_type & extents() const noexcept { return map_.extents(); }
+
+  constexpr mapping_type mapping() const noexcept { return map_; }
+
+  constexpr size_t stripes() const noexcept { return stripes_; }
+
+private:
+
+  static constexpr size_t padding_elements =
+    ( detail::striped_cache_line + sizeof(element_type) - 1 ) / sizeof(element_type);
+
+  static size_t default_stripes() noexcept {
+    const unsigned n = thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+  }
+
+  static ptrdiff_t padded_stride( ptrdiff_t span ) noexcept {
+    const ptrdiff_t line = ptrdiff_t( padding_elements );
+    return ( ( span + line - 1 ) / line ) * line;
+  }
+
+  static element_type * aligned_data( element_type * p ) noexcept {
+    const uintptr_t line = detail::striped_cache_line;
+    const uintptr_t misalignment = reinterpret_cast<uintptr_t>( p ) % line;
+    if( misalignment == 0 || misalignment % sizeof(element_type) != 0 ) return p;
+    return p + ( line - misalignment ) / sizeof(element_type);
+  }
+
+  element_type * stripe( size_t s ) noexcept
+    { return data_ + ptrdiff_t( s ) * stripe_stride_; }
+
+  static void combine( element_type * a , element_type * b , ptrdiff_t n ) noexcept {
+    for( ptrdiff_t i = 0 ; i < n ; i++ ) {
+      a[i] += b[i];
+      b[i] = element_type();
+    }
+  }
+
+  mapping_type map_;
+  size_t stripes_;
+  ptrdiff_t stripe_stride_;
+  vector<element_type> c_;
+  element_type * data_;
+};
+
+}}} // std::experimental::fundamentals_v3
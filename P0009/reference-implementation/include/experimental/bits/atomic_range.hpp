@@ -0,0 +1,195 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <cassert>
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <cstdint> // std::uintptr_t
+#include <type_traits>
+
+// atomic_ref reference implementation of P0019, see MDSPAN_ATOMIC_REF_INCLUDE_DIR
+#include <atomic_ref.hpp>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+namespace detail {
+
+// Bulk updates lock the destination one aligned chunk of memory at a time;
+// a chunk is large enough for the compiler to vectorize the plain loop that
+// updates it and small enough that concurrent bulk updates of different
+// parts of an array rarely meet on the same lock.
+constexpr size_t atomic_range_chunk_bytes = 256;
+
+inline uintptr_t atomic_range_chunk( const void * p ) noexcept
+  { return reinterpret_cast<uintptr_t>( p ) / atomic_range_chunk_bytes; }
+
+inline const void * atomic_range_chunk_lock( uintptr_t chunk ) noexcept
+  { return reinterpret_cast<const void *>( chunk * atomic_range_chunk_bytes ); }
+
+// Calls f(i...) for every multi-index of e, rightmost index fastest
+template<size_t R, class Extents, class F, class... Indices>
+void for_each_index( const Extents & e , F & f , Indices... indices ) {
+  if constexpr( R == Extents::rank() ) {
+    f( indices... );
+  } else {
+    for( typename Extents::index_type i = 0 ; i < e.extent( R ) ; i++ )
+      for_each_index<R+1>( e , f , indices... , i );
+  }
+}
+
+// dst[0,n) += src[0,n), taking the lock of each chunk of dst once and
+// updating all of its elements with plain loads and stores. An element
+// belongs to the chunk holding its first byte.
+template<class ElementType, class SrcElementType>
+void atomic_add_contiguous( ElementType * dst , const SrcElementType * src , ptrdiff_t n ) {
+  const Foo::lock_pool & pool = Foo::lock_pool::global();
+  ptrdiff_t i = 0;
+  while( i < n ) {
+    const uintptr_t chunk = atomic_range_chunk( dst + i );
+    const uintptr_t chunk_end = ( chunk + 1 ) * atomic_range_chunk_bytes;
+    const ptrdiff_t in_chunk = ptrdiff_t(
+      ( chunk_end - reinterpret_cast<uintptr_t>( dst + i ) + sizeof(ElementType) - 1 ) / sizeof(ElementType) );
+    const ptrdiff_t end = n - i < in_chunk ? n : i + in_chunk;
+
+    pool.lock( atomic_range_chunk_lock( chunk ) );
+    for( ; i < end ; i++ ) dst[i] += src[i];
+    pool.unlock( atomic_range_chunk_lock( chunk ) );
+  }
+}
+
+// Calls f(dst_offset, src_value) for every element, in a single pass over
+// the memory if both views are contiguous with the same layout_right (or
+// layout_left) mapping, and index by index otherwise.
+template<class DstMDSpan, class SrcMDSpan, class F>
+void for_each_element_pair( const DstMDSpan & dst , const SrcMDSpan & src , F && f ) {
+  using dst_layout = typename DstMDSpan::layout_type;
+  using src_layout = typename SrcMDSpan::layout_type;
+  static_assert( DstMDSpan::rank() == SrcMDSpan::rank() , "atomic_fetch_add_range: dst and src must have the same rank" );
+#ifndef NDEBUG
+  for( size_t r = 0 ; r < DstMDSpan::rank() ; r++ )
+    assert( ptrdiff_t( dst.extent( r ) ) == ptrdiff_t( src.extent( r ) ) );
+#endif
+
+  // Contiguous layout_right (or layout_left) mappings of equal extents are
+  // all the same bijection onto [0,required_span_size())
+  if constexpr( is_same<dst_layout,src_layout>::value &&
+                ( is_same<dst_layout,layout_right>::value || is_same<dst_layout,layout_left>::value ) &&
+                is_lvalue_reference<typename SrcMDSpan::reference>::value ) {
+    if( dst.is_contiguous() && src.is_contiguous() ) {
+      const auto * const s = src.accessor().decay( src.data() );
+      const ptrdiff_t n = ptrdiff_t( dst.mapping().required_span_size() );
+      for( ptrdiff_t i = 0 ; i < n ; i++ ) f( i , s[i] );
+      return;
+    }
+  }
+
+  auto update = [&]( auto... indices ) {
+    f( ptrdiff_t( dst.mapping()( indices... ) ) , src( indices... ) );
+  };
+  for_each_index<0>( dst.extents() , update );
+}
+
+} // namespace detail
+
+// [mdspan.atomic.range]
+// Adds every element of src to the corresponding element of dst, where
+// dst is an ordinary view and the update of each element is atomic with
+// respect to other atomic_fetch_add_range calls on the same memory.
+// Instead of one atomic read-modify-write per element, the destination is
+// locked a chunk at a time (from Foo::lock_pool::global()) and updated with
+// ordinary, vectorizable arithmetic; contiguous views with the same layout
+// take a single pass over the memory, any other pair of views is walked
+// index by index, taking a chunk lock only when the element moves to a
+// different chunk.
+//
+// This is the fast path for accumulating into a shared buffer. The chunk
+// locks only exclude other bulk updates, so nothing else may access the
+// updated elements concurrently (a barrier between the accumulation phase
+// and any other use of dst is fine). Requires dst.extents() == src.extents().
+//
+// Views through an atomic accessor are not accepted: plain arithmetic under
+// the chunk locks is not atomic with respect to atomic_ref updates of the
+// same elements, and a fetch_add per element is no faster than a loop. For
+// a phase of bulk updates only, pass the plain view of the same memory,
+//   basic_mdspan<T,Extents,Layout>( a.accessor().decay( a.data() ) , a.mapping() )
+template<class ElementType, class Extents, class LayoutPolicy, class AccessorPolicy,
+         class SrcElementType, class SrcExtents, class SrcLayoutPolicy, class SrcAccessorPolicy,
+         typename enable_if<is_same<typename AccessorPolicy::reference,ElementType&>::value,int>::type = 0>
+void atomic_fetch_add_range(
+  const basic_mdspan<ElementType,Extents,LayoutPolicy,AccessorPolicy> & dst ,
+  const basic_mdspan<SrcElementType,SrcExtents,SrcLayoutPolicy,SrcAccessorPolicy> & src )
+{
+  ElementType * const base = dst.accessor().decay( dst.data() );
+
+  if constexpr( is_same<LayoutPolicy,SrcLayoutPolicy>::value &&
+                ( is_same<LayoutPolicy,layout_right>::value || is_same<LayoutPolicy,layout_left>::value ) &&
+                is_lvalue_reference<typename SrcAccessorPolicy::reference>::value ) {
+    if( dst.is_contiguous() && src.is_contiguous() ) {
+      detail::atomic_add_contiguous( base , src.accessor().decay( src.data() ) ,
+                                     ptrdiff_t( dst.mapping().required_span_size() ) );
+      return;
+    }
+  }
+
+  const Foo::lock_pool & pool = Foo::lock_pool::global();
+  bool locked = false;
+  uintptr_t held = 0;
+  detail::for_each_element_pair( dst , src , [&]( ptrdiff_t offset , const auto & value ) {
+    ElementType * const p = base + offset;
+    const uintptr_t chunk = detail::atomic_range_chunk( p );
+    if( !locked || chunk != held ) {
+      if( locked ) pool.unlock( detail::atomic_range_chunk_lock( held ) );
+      pool.lock( detail::atomic_range_chunk_lock( chunk ) );
+      locked = true;
+      held = chunk;
+    }
+    *p += static_cast<ElementType>( value );
+  } );
+  if( locked ) pool.unlock( detail::atomic_range_chunk_lock( held ) );
+}
+
+}}} // std::experimental::fundamentals_v3
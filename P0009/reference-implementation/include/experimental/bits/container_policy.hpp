@@ -0,0 +1,131 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <cstddef> // std::ptrdiff_t
+#include <array> // std::array
+#include <vector> // std::vector
+#include <memory> // std::allocator
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+// A ContainerPolicy creates the container owned by basic_mdarray, accesses
+// its elements and provides the AccessorPolicy of the equivalent basic_mdspan.
+
+// [mdarray.container.vector]
+template<class ElementType, class Allocator = allocator<ElementType> >
+class vector_container_policy {
+public:
+  using element_type          = ElementType;
+  using container_type        = vector<ElementType,Allocator>;
+  using allocator_type        = typename container_type::allocator_type;
+  using pointer               = typename container_type::pointer;
+  using const_pointer         = typename container_type::const_pointer;
+  using reference             = typename container_type::reference;
+  using const_reference       = typename container_type::const_reference;
+  using accessor_policy       = accessor_basic<element_type>;
+  using const_accessor_policy = accessor_basic<const element_type>;
+
+  vector_container_policy() = default;
+
+  explicit vector_container_policy( const allocator_type & a ) noexcept
+    : m_allocator( a ) {}
+
+  container_type create( size_t n ) const
+    { return container_type( n, element_type(), m_allocator ); }
+
+  reference access( container_type & c , ptrdiff_t i ) const noexcept
+    { return c[ size_t(i) ]; }
+
+  const_reference access( const container_type & c , ptrdiff_t i ) const noexcept
+    { return c[ size_t(i) ]; }
+
+  constexpr accessor_policy make_accessor_policy() const noexcept
+    { return accessor_policy(); }
+
+  constexpr const_accessor_policy make_const_accessor_policy() const noexcept
+    { return const_accessor_policy(); }
+
+  allocator_type get_allocator() const noexcept { return m_allocator ; }
+
+private:
+
+  allocator_type m_allocator ;
+};
+
+// [mdarray.container.array]
+// Fixed capacity storage inside the basic_mdarray, no heap allocation.
+template<class ElementType, size_t N>
+class array_container_policy {
+public:
+  using element_type          = ElementType;
+  using container_type        = array<ElementType,N>;
+  using pointer               = ElementType*;
+  using const_pointer         = const ElementType*;
+  using reference             = ElementType&;
+  using const_reference       = const ElementType&;
+  using accessor_policy       = accessor_basic<element_type>;
+  using const_accessor_policy = accessor_basic<const element_type>;
+
+  // Requires n <= N
+  constexpr container_type create( size_t ) const noexcept
+    { return container_type{}; }
+
+  constexpr reference access( container_type & c , ptrdiff_t i ) const noexcept
+    { return c[ size_t(i) ]; }
+
+  constexpr const_reference access( const container_type & c , ptrdiff_t i ) const noexcept
+    { return c[ size_t(i) ]; }
+
+  constexpr accessor_policy make_accessor_policy() const noexcept
+    { return accessor_policy(); }
+
+  constexpr const_accessor_policy make_const_accessor_policy() const noexcept
+    { return const_accessor_policy(); }
+};
+
+}}} // std::experimental::fundamentals_v3
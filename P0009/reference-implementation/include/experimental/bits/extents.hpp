@@ -43,6 +43,8 @@
 
 #include <cstddef> // std::ptrdiff_t
 #include <array> // std::array
+#include <limits> // std::numeric_limits
+#include <type_traits> // std::enable_if
 
 namespace std {
 namespace experimental {
@@ -52,17 +54,20 @@ enum : std::ptrdiff_t { dynamic_extent = -1 };
 
 
 // [mdspan.extents]
+template< class IndexType, std::ptrdiff_t ... StaticExtents >
+class basic_extents;
+
 template< std::ptrdiff_t ... StaticExtents >
-class extents;
+using extents = basic_extents< std::ptrdiff_t, StaticExtents... >;
 
 // [mdspan.extents.compare]
-template<std::ptrdiff_t... LHS, std::ptrdiff_t... RHS>
-constexpr bool operator==(const extents<LHS...>& lhs,
-                          const extents<RHS...>& rhs) noexcept;
+template<class LHSIndexType, std::ptrdiff_t... LHS, class RHSIndexType, std::ptrdiff_t... RHS>
+constexpr bool operator==(const basic_extents<LHSIndexType,LHS...>& lhs,
+                          const basic_extents<RHSIndexType,RHS...>& rhs) noexcept;
 
-template<std::ptrdiff_t... LHS, std::ptrdiff_t... RHS>
-constexpr bool operator!=(const extents<LHS...>& lhs,
-                          const extents<RHS...>& rhs) noexcept;
+template<class LHSIndexType, std::ptrdiff_t... LHS, class RHSIndexType, std::ptrdiff_t... RHS>
+constexpr bool operator!=(const basic_extents<LHSIndexType,LHS...>& lhs,
+                          const basic_extents<RHSIndexType,RHS...>& rhs) noexcept;
 
 
 }}}
@@ -74,147 +79,115 @@ namespace std {
 namespace experimental {
 inline namespace fundamentals_v3 {
 namespace detail {
-  template< int R, std::ptrdiff_t ... StaticExtents >
-  struct extents_analyse;
-
-  template< int R, std::ptrdiff_t E0, std::ptrdiff_t ... StaticExtents >
-  struct extents_analyse<R,E0,StaticExtents...> {
-
-    typedef extents_analyse<R-1,StaticExtents...> next_extents_analyse;
-
-    static constexpr std::size_t rank() noexcept { return next_extents_analyse::rank()+1; }
-    static constexpr std::size_t rank_dynamic() noexcept { return next_extents_analyse::rank_dynamic(); }
-
-    next_extents_analyse next;
 
-    extents_analyse():next() {};
- 
-    template<class...DynamicExtents>
-    extents_analyse(DynamicExtents...de):next(de...) {}
-
-    template<std::size_t Rank>
-    extents_analyse(const array<std::ptrdiff_t,Rank>& de,const std::size_t r):next(de,r) {}
-
-    template<std::ptrdiff_t...OtherStaticExtents>
-    extents_analyse(extents_analyse<R,OtherStaticExtents...> rhs):next(rhs.next) {}    
-
-    template<std::ptrdiff_t...OtherStaticExtents>
-    extents_analyse operator= (extents_analyse<R,OtherStaticExtents...> rhs) {
-      next = rhs.next;
-      return *this;
-    }
-    
-    constexpr std::ptrdiff_t extent(const std::size_t r) const noexcept {
-      if(r==R) return E0;
-      return next.extent(r); 
+  // Static properties of a basic_extents<IndexType,StaticExtents...> pack. The dynamic
+  // extents are stored in a flat array, extent r is found at
+  // dynamic_index[r] of that array if static_extents[r]==dynamic_extent.
+  template< std::ptrdiff_t ... StaticExtents >
+  struct extents_analyse {
+
+    static constexpr std::size_t rank() noexcept { return sizeof...(StaticExtents); }
+    static constexpr std::size_t rank_dynamic() noexcept
+      { return ( std::size_t(0) + ... + std::size_t(StaticExtents == dynamic_extent) ); }
+
+    static constexpr std::array<std::ptrdiff_t,sizeof...(StaticExtents)> static_extents = {{ StaticExtents... }};
+
+    static constexpr std::array<std::size_t,sizeof...(StaticExtents)> compute_dynamic_index() noexcept {
+      std::array<std::size_t,sizeof...(StaticExtents)> index{};
+      std::size_t d = 0;
+      for(std::size_t r = 0; r<rank(); r++) {
+        index[r] = d;
+        if(static_extents[r] == dynamic_extent) d++;
+      }
+      return index;
     }
-    static constexpr std::ptrdiff_t static_extent(const std::size_t r) noexcept {
-      if(r==R) return E0;
-      return next_extents_analyse::static_extent(r);
-    }
-  };
-
-  template< int R, std::ptrdiff_t ... StaticExtents >
-  struct extents_analyse<R,dynamic_extent,StaticExtents...> {
-    typedef extents_analyse<R-1,StaticExtents...> next_extents_analyse;
-
-    static constexpr std::size_t rank() noexcept { return next_extents_analyse::rank()+1; }
-    static constexpr std::size_t rank_dynamic() noexcept { return next_extents_analyse::rank_dynamic()+1; }
-
-    next_extents_analyse next;
-    std::ptrdiff_t this_extent;
-
-    extents_analyse():next(),this_extent(0) {}
-
-    template<class...DynamicExtents>
-    extents_analyse(std::ptrdiff_t E, DynamicExtents...de):next(de...),this_extent(E) {}
 
-    template<std::size_t Rank>
-    extents_analyse(const array<std::ptrdiff_t,Rank>& de, const std::size_t r):next(de,r+1),this_extent(de[r]) {}
+    static constexpr std::array<std::size_t,sizeof...(StaticExtents)> dynamic_index = compute_dynamic_index();
 
-    template<std::ptrdiff_t...OtherStaticExtents>
-    extents_analyse(extents_analyse<R,OtherStaticExtents...> rhs):next(rhs.next),this_extent(rhs.extent(R)) {}    
-
-    template<std::ptrdiff_t...OtherStaticExtents>
-    extents_analyse & operator= (extents_analyse<R,OtherStaticExtents...> rhs) {
-      next = rhs.next;
-      this_extent = rhs.extent(R);
-      return *this;
-    }    
-
-    constexpr std::ptrdiff_t extent(const std::size_t r) const noexcept {
-      if(r==R) return this_extent; 
-      else return next.extent(r);
-    }
     static constexpr std::ptrdiff_t static_extent(const std::size_t r) noexcept {
-      if(r==R) return dynamic_extent;
-      return next_extents_analyse::static_extent(r);
+      if(r>=rank()) return 1;
+      return static_extents[r];
     }
   };
 
-  template<>
-  struct extents_analyse<0> {
-    static constexpr std::size_t rank() noexcept { return 0; }
-    static constexpr std::size_t rank_dynamic() noexcept { return 0; }
+  // Flat storage of the dynamic extents, an empty class if there are none.
+  template< class IndexType, std::size_t RankDynamic >
+  struct extents_storage {
+    std::array<IndexType,RankDynamic> m_dynamic_extents;
 
-    extents_analyse() {}
+    constexpr extents_storage() noexcept : m_dynamic_extents() {}
 
-    template<std::size_t Rank>
-    extents_analyse(const array<std::ptrdiff_t,Rank>&, const std::size_t) {}
+    constexpr extents_storage( const std::array<IndexType,RankDynamic>& de ) noexcept
+      : m_dynamic_extents(de) {}
+  };
 
-    //extents_analyse & operator=(extents_analyse) = default;
-
-    constexpr std::ptrdiff_t extent(const std::size_t) const noexcept {
-      return 1;
-    }
-    static constexpr std::ptrdiff_t static_extent(const std::size_t) noexcept {
-      return 1;
-    }
+  template< class IndexType >
+  struct extents_storage<IndexType,0> {
+    constexpr extents_storage() noexcept {}
 
+    constexpr extents_storage( const std::array<IndexType,0>& ) noexcept {}
   };
+
+  // Converting between index types is implicit unless it may narrow.
+  template< class To, class From >
+  constexpr bool index_type_narrows() noexcept
+    { return std::numeric_limits<To>::max() < std::numeric_limits<From>::max(); }
 }
 
-template< std::ptrdiff_t ... StaticExtents >
-class extents
+template< class IndexType, std::ptrdiff_t ... StaticExtents >
+class basic_extents
+  : private detail::extents_storage< IndexType, detail::extents_analyse<StaticExtents...>::rank_dynamic() >
 {
 private:
 
-  template< std::ptrdiff_t... > friend class extents ;
+  static_assert( std::is_integral<IndexType>::value , "basic_extents: IndexType must be an integral type" );
+
+  template< class, std::ptrdiff_t... > friend class basic_extents ;
+
+  typedef detail::extents_analyse<StaticExtents...> extents_analyse_t;
+  typedef detail::extents_storage<IndexType,extents_analyse_t::rank_dynamic()> extents_storage_t;
 
-  typedef detail::extents_analyse<sizeof...(StaticExtents),StaticExtents...> extents_analyse_t;
-  extents_analyse_t impl;
 public:
 
-  using index_type = std::ptrdiff_t ;
+  using index_type = IndexType ;
 
-  constexpr extents() noexcept {}
+  constexpr basic_extents() noexcept : extents_storage_t() {}
 
-  constexpr extents( extents && ) noexcept = default ;
+  constexpr basic_extents( basic_extents && ) noexcept = default ;
 
-  constexpr extents( const extents & ) noexcept = default ;
+  constexpr basic_extents( const basic_extents & ) noexcept = default ;
 
-  template< class ... IndexType >
-  constexpr extents( std::ptrdiff_t dn,
-                              IndexType ... DynamicExtents ) noexcept
-    : impl( dn , DynamicExtents... ) 
+  template< class ... OtherIndexType >
+  constexpr basic_extents( index_type dn,
+                           OtherIndexType ... DynamicExtents ) noexcept
+    : extents_storage_t( array<index_type,extents_analyse_t::rank_dynamic()>{{ dn , index_type(DynamicExtents)... }} )
     { static_assert( 1+sizeof...(DynamicExtents) == rank_dynamic() , "" ); }
 
-  constexpr extents( const array<std::ptrdiff_t,extents_analyse_t::rank_dynamic()> dynamic_extents) noexcept
-    : impl(dynamic_extents,0) {}
+  constexpr basic_extents( const array<index_type,extents_analyse_t::rank_dynamic()> dynamic_extents) noexcept
+    : extents_storage_t(dynamic_extents) {}
 
-  template<std::ptrdiff_t... OtherStaticExtents>
-  extents( const extents<OtherStaticExtents...>& other )
-    : impl( other.impl ) {}
+  template<class OtherIndexType, std::ptrdiff_t... OtherStaticExtents,
+           typename enable_if<!detail::index_type_narrows<index_type,OtherIndexType>(),int>::type = 0>
+  constexpr basic_extents( const basic_extents<OtherIndexType,OtherStaticExtents...>& other ) noexcept
+    : extents_storage_t()
+    { assign_dynamic_extents( other ); }
 
-  extents & operator = ( extents && ) noexcept = default;
+  template<class OtherIndexType, std::ptrdiff_t... OtherStaticExtents,
+           typename enable_if<detail::index_type_narrows<index_type,OtherIndexType>(),int>::type = 0>
+  explicit constexpr basic_extents( const basic_extents<OtherIndexType,OtherStaticExtents...>& other ) noexcept
+    : extents_storage_t()
+    { assign_dynamic_extents( other ); }
 
-  extents & operator = ( const extents & ) noexcept = default;
+  basic_extents & operator = ( basic_extents && ) noexcept = default;
 
-  template<std::ptrdiff_t... OtherStaticExtents>
-  extents & operator = ( const extents<OtherStaticExtents...>& other )
-    { impl = other.impl; return *this ; }
+  basic_extents & operator = ( const basic_extents & ) noexcept = default;
 
-  ~extents() = default ;
+  template<class OtherIndexType, std::ptrdiff_t... OtherStaticExtents>
+  typename enable_if<!detail::index_type_narrows<index_type,OtherIndexType>(),basic_extents&>::type
+  operator = ( const basic_extents<OtherIndexType,OtherStaticExtents...>& other )
+    { assign_dynamic_extents( other ); return *this ; }
+
+  ~basic_extents() = default ;
 
   // [mdspan.extents.obs]
 
@@ -224,26 +197,47 @@ public:
   static constexpr std::size_t rank_dynamic() noexcept 
     { return extents_analyse_t::rank_dynamic() ; }
 
-  static constexpr index_type static_extent(std::size_t k) noexcept
-    { return extents_analyse_t::static_extent(rank()-k); }
+  // Static extents are template arguments of type ptrdiff_t, which keeps
+  // dynamic_extent distinguishable for unsigned index types.
+  static constexpr std::ptrdiff_t static_extent(std::size_t k) noexcept
+    { return extents_analyse_t::static_extent(k); }
 
   constexpr index_type extent(std::size_t k) const noexcept
-    { return impl.extent(rank()-k); }
+    {
+      if constexpr ( rank_dynamic() > 0 ) {
+        if( k<rank() && extents_analyse_t::static_extents[k] == dynamic_extent )
+          return this->m_dynamic_extents[extents_analyse_t::dynamic_index[k]];
+      }
+      return index_type(static_extent(k));
+    }
+
+private:
+
+  template<class OtherIndexType, std::ptrdiff_t... OtherStaticExtents>
+  constexpr void assign_dynamic_extents( const basic_extents<OtherIndexType,OtherStaticExtents...>& other ) noexcept
+    {
+      static_assert( sizeof...(OtherStaticExtents) == rank() , "" );
+      if constexpr ( rank_dynamic() > 0 ) {
+        for(std::size_t r = 0; r<rank(); r++)
+          if( extents_analyse_t::static_extents[r] == dynamic_extent )
+            this->m_dynamic_extents[extents_analyse_t::dynamic_index[r]] = index_type(other.extent(r));
+      }
+    }
 
 };
 
-template<std::ptrdiff_t... LHS, std::ptrdiff_t... RHS>
-constexpr bool operator==(const extents<LHS...>& lhs,
-                          const extents<RHS...>& rhs) noexcept { 
+template<class LHSIndexType, std::ptrdiff_t... LHS, class RHSIndexType, std::ptrdiff_t... RHS>
+constexpr bool operator==(const basic_extents<LHSIndexType,LHS...>& lhs,
+                          const basic_extents<RHSIndexType,RHS...>& rhs) noexcept { 
   bool equal = lhs.rank() == rhs.rank();
   for(std::size_t r = 0; r<lhs.rank(); r++)
-    equal = equal && ( lhs.extent(r) == rhs.extent(r) ); 
+    equal = equal && ( std::ptrdiff_t(lhs.extent(r)) == std::ptrdiff_t(rhs.extent(r)) ); 
   return equal; 
 }
 
-template<std::ptrdiff_t... LHS, std::ptrdiff_t... RHS>
-constexpr bool operator!=(const extents<LHS...>& lhs,
-                          const extents<RHS...>& rhs) noexcept { 
+template<class LHSIndexType, std::ptrdiff_t... LHS, class RHSIndexType, std::ptrdiff_t... RHS>
+constexpr bool operator!=(const basic_extents<LHSIndexType,LHS...>& lhs,
+                          const basic_extents<RHSIndexType,RHS...>& rhs) noexcept { 
   return !(lhs==rhs);
 }
 
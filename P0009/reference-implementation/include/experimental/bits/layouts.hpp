@@ -41,6 +41,11 @@
 // ************************************************************************
 //@HEADER
 
+#include <cstddef> // std::ptrdiff_t
+#include <array> // std::array
+#include <utility> // std::index_sequence
+#include <type_traits> // std::enable_if
+
 //--------------------------------------------------------------------------
 //--------------------------------------------------------------------------
 
@@ -53,11 +58,119 @@ class layout_right ;
 class layout_left ;
 class layout_stride ;
 
+template<ptrdiff_t PaddingValue = dynamic_extent>
+class layout_left_padded ;
+template<ptrdiff_t PaddingValue = dynamic_extent>
+class layout_right_padded ;
+
 }}}
 
 //--------------------------------------------------------------------------
 //--------------------------------------------------------------------------
 
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace detail {
+
+  template<class Extents>
+  constexpr array<ptrdiff_t,Extents::rank()> static_extents_of() noexcept {
+    array<ptrdiff_t,Extents::rank()> ext{};
+    for(size_t r = 0; r<Extents::rank(); r++)
+      ext[r] = Extents::static_extent(r);
+    return ext;
+  }
+
+  // The helpers below take the static extents that multiply into the
+  // strides. For layout_left / layout_right these are the static extents,
+  // padded layouts replace the leading extent by the padding stride.
+
+  // Product of the static extents [begin,end),
+  // or dynamic_extent if any of them is dynamic.
+  template<size_t N>
+  constexpr ptrdiff_t static_extents_product( const array<ptrdiff_t,N>& ext, size_t begin, size_t end ) noexcept {
+    ptrdiff_t product = 1;
+    for(size_t r = begin; r<end; r++) {
+      if(ext[r] == dynamic_extent) return dynamic_extent;
+      product *= ext[r];
+    }
+    return product;
+  }
+
+  template<class IndexType, size_t N>
+  constexpr array<IndexType,N> layout_right_static_strides( const array<ptrdiff_t,N>& ext ) noexcept {
+    array<IndexType,N> strides{};
+    for(size_t r = 0; r<N; r++)
+      strides[r] = IndexType( static_extents_product( ext, r+1, N ) );
+    return strides;
+  }
+
+  template<class IndexType, size_t N>
+  constexpr array<IndexType,N> layout_left_static_strides( const array<ptrdiff_t,N>& ext ) noexcept {
+    array<IndexType,N> strides{};
+    for(size_t r = 0; r<N; r++)
+      strides[r] = IndexType( static_extents_product( ext, 0, r ) );
+    return strides;
+  }
+
+  // layout_right: stride(r) is dynamic iff an extent right of r is dynamic,
+  // i.e. for r < index of the last dynamic extent.
+  template<size_t N>
+  constexpr size_t layout_right_dynamic_strides( const array<ptrdiff_t,N>& ext ) noexcept {
+    size_t n = 0;
+    for(size_t r = 0; r<N; r++)
+      if(ext[r] == dynamic_extent) n = r;
+    return n;
+  }
+
+  // layout_left: stride(r) is dynamic iff an extent left of r is dynamic,
+  // i.e. for r > index of the first dynamic extent.
+  template<size_t N>
+  constexpr size_t layout_left_dynamic_strides( const array<ptrdiff_t,N>& ext ) noexcept {
+    for(size_t r = 0; r<N; r++)
+      if(ext[r] == dynamic_extent) return N-1-r;
+    return 0;
+  }
+
+  // LEAST-MULTIPLE-AT-LEAST(x,y): the smallest multiple of x not less than y
+  template<class IndexType>
+  constexpr IndexType least_multiple_at_least( IndexType x, IndexType y ) noexcept {
+    return x == 0 ? y : ( ( y + x - 1 ) / x ) * x;
+  }
+
+  // Compile time value of the padding stride of a padded layout, i.e.
+  // stride(1) of layout_left_padded or stride(rank-2) of layout_right_padded.
+  constexpr ptrdiff_t static_padding_stride( ptrdiff_t padding_value, size_t rank, ptrdiff_t padded_extent ) noexcept {
+    if(rank<=1) return 0;
+    if(padding_value == dynamic_extent || padded_extent == dynamic_extent) return dynamic_extent;
+    return least_multiple_at_least( padding_value, padded_extent );
+  }
+
+  // Static extents with the padded one replaced by the padding stride.
+  template<size_t N>
+  constexpr array<ptrdiff_t,N> padded_static_extents( array<ptrdiff_t,N> ext, size_t padded_rank, ptrdiff_t padding_stride ) noexcept {
+    if(N>1) ext[padded_rank] = padding_stride;
+    return ext;
+  }
+
+  template<class Layout>
+  struct is_layout_left_padded : false_type {};
+
+  template<ptrdiff_t PaddingValue>
+  struct is_layout_left_padded<layout_left_padded<PaddingValue>> : true_type {};
+
+  template<class Layout>
+  struct is_layout_right_padded : false_type {};
+
+  template<ptrdiff_t PaddingValue>
+  struct is_layout_right_padded<layout_right_padded<PaddingValue>> : true_type {};
+
+} // namespace detail
+}}} // experimental::fundamentals_v3
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
 
 namespace std {
 namespace experimental {
@@ -70,14 +183,23 @@ public:
   class mapping {
   private:
 
+    // Strides [0,dynamic_strides) depend on dynamic extents and are
+    // computed once at construction, all others are compile time constants.
+    static constexpr array<ptrdiff_t,Extents::rank()> static_extents = detail::static_extents_of<Extents>();
+    static constexpr size_t dynamic_strides = detail::layout_right_dynamic_strides( static_extents );
+    static constexpr array<typename Extents::index_type,Extents::rank()> static_strides =
+      detail::layout_right_static_strides<typename Extents::index_type>( static_extents );
+
     Extents m_extents ;
+    array<typename Extents::index_type,dynamic_strides> m_strides ;
 
   public:
 
-    using index_type = ptrdiff_t ;
+    using index_type = typename Extents::index_type ;
     using extents_type = Extents ;
+    using layout_type = layout_right ;
 
-    constexpr mapping() noexcept = default ;
+    constexpr mapping() noexcept : mapping( Extents() ) {}
 
     constexpr mapping( mapping && ) noexcept = default ;
 
@@ -88,39 +210,50 @@ public:
     mapping & operator = ( const mapping & ) noexcept = default ;
 
     constexpr mapping( const Extents & ext ) noexcept
-      : m_extents( ext ) {}
+      : m_extents( ext ), m_strides()
+      {
+        index_type stride_ = index_type( detail::static_extents_product( static_extents, dynamic_strides+1, Extents::rank() ) );
+        for(size_t r = dynamic_strides; r>0; r--) {
+          stride_ *= m_extents.extent(r);
+          m_strides[r-1] = stride_;
+        }
+      }
+
+    // Precondition: other.is_contiguous()
+    template<class OtherMapping,
+             typename enable_if<detail::is_layout_right_padded<typename OtherMapping::layout_type>::value,int>::type = 0>
+    explicit constexpr mapping( const OtherMapping & other ) noexcept
+      : mapping( Extents( other.extents() ) ) {}
 
     constexpr const Extents & extents() const noexcept { return m_extents ; }
 
   private:
 
-    // ( ( ( ( i0 ) * N1 + i1 ) * N2 + i2 ) * N3 + i3 ) ...
+    template<size_t R>
+    constexpr index_type static_or_cached_stride() const noexcept {
+      if constexpr ( R < dynamic_strides ) return m_strides[R];
+      else return static_strides[R];
+    }
 
-    static constexpr index_type
-    offset( const size_t , const ptrdiff_t sum)
-      { return sum; }
+    // i0 * S0 + i1 * S1 + ... + in , with S(r) = N(r+1) * ... * Nn
 
-    template<class ... Indices >
-    inline constexpr index_type
-    offset( const size_t r, ptrdiff_t sum, const index_type i, Indices... indices) const noexcept
-      {
-        return offset( r+1 , sum * m_extents.extent(r) + i, indices...);
-      }
+    template<size_t ... R, class ... Indices >
+    constexpr index_type
+    offset( index_sequence<R...>, Indices... indices ) const noexcept
+      { return ( index_type(0) + ... + ( index_type(indices) * static_or_cached_stride<R>() ) ); }
 
   public:
 
     constexpr index_type required_span_size() const noexcept { 
-      index_type size = 1;
-      for(size_t r=0; r<m_extents.rank(); r++)
-        size *= m_extents.extent(r);
-      return size;
+      if constexpr ( Extents::rank() == 0 ) return 1;
+      else return static_or_cached_stride<0>() * m_extents.extent(0);
     } 
 
     template<class ... Indices >
     constexpr
     typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
     operator()( Indices ... indices ) const noexcept 
-      { return offset( 0, 0, indices... ); }
+      { return offset( make_index_sequence<sizeof...(Indices)>(), indices... ); }
 
     static constexpr bool is_always_unique()     noexcept { return true ; }
     static constexpr bool is_always_contiguous() noexcept { return true ; }
@@ -131,10 +264,10 @@ public:
     constexpr bool is_strided()    const noexcept { return true ; }
 
     constexpr index_type stride(const size_t R) const noexcept { 
-      ptrdiff_t stride_ = 1;
-      for(size_t r = m_extents.rank()-1; r>R; r--)
-        stride_ *= m_extents.extent(r);
-      return stride_;
+      if constexpr ( dynamic_strides > 0 ) {
+        if ( R < dynamic_strides ) return m_strides[R];
+      }
+      return static_strides[R];
     }
 
   }; // class mapping
@@ -155,14 +288,24 @@ public:
   class mapping {
   private:
 
+    // Strides [rank-dynamic_strides,rank) depend on dynamic extents and are
+    // computed once at construction, all others are compile time constants.
+    static constexpr array<ptrdiff_t,Extents::rank()> static_extents = detail::static_extents_of<Extents>();
+    static constexpr size_t dynamic_strides = detail::layout_left_dynamic_strides( static_extents );
+    static constexpr size_t first_dynamic_stride = Extents::rank()-dynamic_strides;
+    static constexpr array<typename Extents::index_type,Extents::rank()> static_strides =
+      detail::layout_left_static_strides<typename Extents::index_type>( static_extents );
+
     Extents m_extents ;
+    array<typename Extents::index_type,dynamic_strides> m_strides ;
 
   public:
 
-    using index_type = ptrdiff_t ;
+    using index_type = typename Extents::index_type ;
     using extents_type = Extents ;
+    using layout_type = layout_left ;
 
-    constexpr mapping() noexcept = default ;
+    constexpr mapping() noexcept : mapping( Extents() ) {}
 
     constexpr mapping( mapping && ) noexcept = default ;
 
@@ -173,37 +316,52 @@ public:
     mapping & operator = ( const mapping & ) noexcept = default ;
 
     constexpr mapping( const Extents & ext ) noexcept
-      : m_extents( ext ) {}
+      : m_extents( ext ), m_strides()
+      {
+        if constexpr ( dynamic_strides > 0 ) {
+          index_type stride_ = static_strides[first_dynamic_stride-1];
+          for(size_t r = first_dynamic_stride; r<Extents::rank(); r++) {
+            stride_ *= m_extents.extent(r-1);
+            m_strides[r-first_dynamic_stride] = stride_;
+          }
+        }
+      }
+
+    // Precondition: other.is_contiguous()
+    template<class OtherMapping,
+             typename enable_if<detail::is_layout_left_padded<typename OtherMapping::layout_type>::value,int>::type = 0>
+    explicit constexpr mapping( const OtherMapping & other ) noexcept
+      : mapping( Extents( other.extents() ) ) {}
 
     constexpr const Extents & extents() const noexcept { return m_extents ; }
 
   private:
 
-    // ( i0 + N0 * ( i1 + N1 * ( i2 + N2 * ( ... ) ) ) )
+    template<size_t R>
+    constexpr index_type static_or_cached_stride() const noexcept {
+      if constexpr ( R >= first_dynamic_stride ) return m_strides[R-first_dynamic_stride];
+      else return static_strides[R];
+    }
 
-    static constexpr index_type
-    offset( size_t ) noexcept
-      { return 0 ; }
+    // i0 + i1 * S1 + i2 * S2 + ... , with S(r) = N0 * ... * N(r-1)
 
-    template<class ... IndexType >
+    template<size_t ... R, class ... Indices >
     constexpr index_type
-    offset( const size_t r, index_type i, IndexType... indices ) const noexcept
-      { return i + m_extents.extent(r) * offset( r+1, indices... ); }
+    offset( index_sequence<R...>, Indices... indices ) const noexcept
+      { return ( index_type(0) + ... + ( index_type(indices) * static_or_cached_stride<R>() ) ); }
 
   public:
 
     constexpr index_type required_span_size() const noexcept {
-      ptrdiff_t size = 1;
-      for(size_t r = 0; r<m_extents.rank(); r++)
-        size *= m_extents.extent(r);
-      return size;
+      if constexpr ( Extents::rank() == 0 ) return 1;
+      else return static_or_cached_stride<Extents::rank()-1>() * m_extents.extent(Extents::rank()-1);
     }
 
     template<class ... Indices >
     constexpr
     typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
     operator()( Indices ... indices ) const noexcept
-      { return offset( 0, indices... ); }
+      { return offset( make_index_sequence<sizeof...(Indices)>(), indices... ); }
 
     static constexpr bool is_always_unique()     noexcept { return true ; }
     static constexpr bool is_always_contiguous() noexcept { return true ; }
@@ -214,10 +372,10 @@ public:
     constexpr bool is_strided()    const noexcept { return true ; }
 
     constexpr index_type stride(const size_t R) const noexcept {
-      ptrdiff_t stride_ = 1;
-      for(size_t r = 0; r<R; r++)
-        stride_ *= m_extents.extent(r);
-      return stride_;
+      if constexpr ( dynamic_strides > 0 ) {
+        if ( R >= first_dynamic_stride ) return m_strides[R-first_dynamic_stride];
+      }
+      return static_strides[R];
     }
 
   }; // class mapping
@@ -240,7 +398,7 @@ public:
   class mapping {
   private:
 
-    using stride_t = array<ptrdiff_t,Extents::rank()> ;
+    using stride_t = array<typename Extents::index_type,Extents::rank()> ;
 
     Extents   m_extents ;
     stride_t  m_stride ;
@@ -248,8 +406,9 @@ public:
 
   public:
 
-    using index_type = ptrdiff_t ;
+    using index_type = typename Extents::index_type ;
     using extents_type = Extents ;
+    using layout_type = layout_stride ;
 
     constexpr mapping() noexcept = default ;
 
@@ -287,10 +446,25 @@ public:
         }
       }
 
+    template<class OtherMapping,
+             typename enable_if<OtherMapping::is_always_strided() &&
+                                OtherMapping::extents_type::rank() == Extents::rank(),int>::type = 0,
+             class = typename OtherMapping::layout_type>
+    explicit mapping( const OtherMapping & other ) noexcept
+      : mapping( Extents( other.extents() ), strides_of( other ) ) {}
+
     constexpr const Extents & extents() const noexcept { return m_extents ; }
 
   private:
 
+    template<class OtherMapping>
+    static stride_t strides_of( const OtherMapping & other ) noexcept
+      {
+        stride_t str{};
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) str[i] = other.stride(i);
+        return str ;
+      }
+
     // i0 * N0 + i1 * N1 + i2 * N2 + ...
 
     constexpr index_type
@@ -304,12 +478,15 @@ public:
 
   public:
 
+    // One past the largest offset, or 0 if there are no elements
     index_type required_span_size() const noexcept
       {
         index_type max = 0 ;
-        for ( size_t i = 0 ; i < Extents::rank() ; ++i )
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
+          if ( m_extents.extent(i) == 0 ) return 0 ;
           max += m_stride[i] * ( m_extents.extent(i) - 1 );
-        return max ;
+        }
+        return max + 1 ;
       }
 
     template<class ... Indices >
@@ -335,3 +512,305 @@ public:
 }; // class layout_stride
 
 }}} // experimental::fundamentals_v3
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+// layout_left with stride(1) padded to a multiple of PaddingValue,
+// e.g. a column major matrix whose columns start at SIMD aligned offsets.
+template<ptrdiff_t PaddingValue>
+class layout_left_padded {
+public:
+  template<class Extents>
+  class mapping {
+  public:
+
+    static constexpr ptrdiff_t padding_value = PaddingValue ;
+
+  private:
+
+    static_assert( PaddingValue == dynamic_extent || PaddingValue > 0 , "layout_left_padded: PaddingValue must be positive" );
+
+    static constexpr ptrdiff_t static_padding_stride =
+      detail::static_padding_stride( PaddingValue, Extents::rank(), Extents::static_extent(0) );
+
+    // Strides are those of layout_left with extent(0) replaced by the padding stride.
+    static constexpr array<ptrdiff_t,Extents::rank()> static_extents =
+      detail::padded_static_extents( detail::static_extents_of<Extents>(), 0, static_padding_stride );
+    static constexpr size_t dynamic_strides = detail::layout_left_dynamic_strides( static_extents );
+    static constexpr size_t first_dynamic_stride = Extents::rank()-dynamic_strides;
+    static constexpr array<typename Extents::index_type,Extents::rank()> static_strides =
+      detail::layout_left_static_strides<typename Extents::index_type>( static_extents );
+
+    Extents m_extents ;
+    array<typename Extents::index_type,dynamic_strides> m_strides ;
+
+  public:
+
+    using index_type = typename Extents::index_type ;
+    using extents_type = Extents ;
+    using layout_type = layout_left_padded ;
+
+    constexpr mapping() noexcept : mapping( Extents() ) {}
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    constexpr mapping( const Extents & ext ) noexcept
+      : mapping( ext, PaddingValue == dynamic_extent ? ext.extent(0) : index_type(PaddingValue) ) {}
+
+    // pad must equal padding_value unless padding_value is dynamic_extent
+    constexpr mapping( const Extents & ext, index_type pad ) noexcept
+      : m_extents( ext ), m_strides()
+      {
+        if constexpr ( dynamic_strides > 0 ) {
+          index_type stride_ = static_strides[first_dynamic_stride-1];
+          for(size_t r = first_dynamic_stride; r<Extents::rank(); r++) {
+            stride_ *= r == 1 ? detail::least_multiple_at_least( pad, m_extents.extent(0) )
+                              : m_extents.extent(r-1);
+            m_strides[r-first_dynamic_stride] = stride_;
+          }
+        }
+      }
+
+    template<class OtherExtents>
+    constexpr mapping( const layout_left::mapping<OtherExtents> & other ) noexcept
+      : mapping( Extents( other.extents() ) ) {}
+
+    // Preconditions: other.stride(0) == 1 and
+    // other.stride(r) == other.stride(1) * extent(1) * ... * extent(r-1)
+    template<class OtherExtents>
+    explicit constexpr mapping( const layout_stride::mapping<OtherExtents> & other ) noexcept
+      : mapping( Extents( other.extents() ), Extents::rank() > 1 ? index_type( other.stride(1) ) : index_type(1) ) {}
+
+    template<class OtherMapping,
+             typename enable_if<detail::is_layout_left_padded<typename OtherMapping::layout_type>::value,int>::type = 0>
+    constexpr mapping( const OtherMapping & other ) noexcept
+      : mapping( Extents( other.extents() ), Extents::rank() > 1 ? index_type( other.stride(1) ) : index_type(1) ) {}
+
+    // layout_right and layout_left coincide for rank < 2
+    template<class OtherExtents, size_t Rank = Extents::rank(),
+             typename enable_if<( Rank < 2 ),int>::type = 0>
+    constexpr mapping( const layout_right::mapping<OtherExtents> & other ) noexcept
+      : mapping( Extents( other.extents() ) ) {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+  private:
+
+    template<size_t R>
+    constexpr index_type static_or_cached_stride() const noexcept {
+      if constexpr ( R >= first_dynamic_stride ) return m_strides[R-first_dynamic_stride];
+      else return static_strides[R];
+    }
+
+    // i0 + i1 * S1 + i2 * S2 + ... , with S1 >= N0 and S(r) = S1 * N1 * ... * N(r-1)
+
+    template<size_t ... R, class ... Indices >
+    constexpr index_type
+    offset( index_sequence<R...>, Indices... indices ) const noexcept
+      { return ( index_type(0) + ... + ( index_type(indices) * static_or_cached_stride<R>() ) ); }
+
+  public:
+
+    constexpr index_type required_span_size() const noexcept {
+      if constexpr ( Extents::rank() == 0 ) return 1;
+      else if constexpr ( Extents::rank() == 1 ) return m_extents.extent(0);
+      else {
+        // offset of the last element plus one, zero if any extent is zero
+        const index_type size = static_or_cached_stride<Extents::rank()-1>() * m_extents.extent(Extents::rank()-1);
+        return size == 0 ? 0 : size - static_or_cached_stride<1>() + m_extents.extent(0);
+      }
+    }
+
+    template<class ... Indices >
+    constexpr
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    operator()( Indices ... indices ) const noexcept
+      { return offset( make_index_sequence<sizeof...(Indices)>(), indices... ); }
+
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept {
+      return Extents::rank() < 2 ||
+             ( static_padding_stride != dynamic_extent && static_padding_stride == Extents::static_extent(0) );
+    }
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept {
+      if constexpr ( Extents::rank() < 2 ) return true ;
+      else return static_or_cached_stride<1>() == m_extents.extent(0) ;
+    }
+    constexpr bool is_strided()    const noexcept { return true ; }
+
+    constexpr index_type stride(const size_t R) const noexcept {
+      if constexpr ( dynamic_strides > 0 ) {
+        if ( R >= first_dynamic_stride ) return m_strides[R-first_dynamic_stride];
+      }
+      return static_strides[R];
+    }
+
+  }; // class mapping
+
+}; // class layout_left_padded
+
+}}} // experimental::fundamentals_v3
+
+//----------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+// layout_right with stride(rank-2) padded to a multiple of PaddingValue,
+// e.g. a row major matrix whose rows start at SIMD aligned offsets.
+template<ptrdiff_t PaddingValue>
+class layout_right_padded {
+public:
+  template<class Extents>
+  class mapping {
+  public:
+
+    static constexpr ptrdiff_t padding_value = PaddingValue ;
+
+  private:
+
+    static_assert( PaddingValue == dynamic_extent || PaddingValue > 0 , "layout_right_padded: PaddingValue must be positive" );
+
+    static constexpr size_t last_rank = Extents::rank() > 0 ? Extents::rank()-1 : 0 ;
+
+    static constexpr ptrdiff_t static_padding_stride =
+      detail::static_padding_stride( PaddingValue, Extents::rank(), Extents::static_extent(last_rank) );
+
+    // Strides are those of layout_right with extent(rank-1) replaced by the padding stride.
+    static constexpr array<ptrdiff_t,Extents::rank()> static_extents =
+      detail::padded_static_extents( detail::static_extents_of<Extents>(), last_rank, static_padding_stride );
+    static constexpr size_t dynamic_strides = detail::layout_right_dynamic_strides( static_extents );
+    static constexpr array<typename Extents::index_type,Extents::rank()> static_strides =
+      detail::layout_right_static_strides<typename Extents::index_type>( static_extents );
+
+    Extents m_extents ;
+    array<typename Extents::index_type,dynamic_strides> m_strides ;
+
+  public:
+
+    using index_type = typename Extents::index_type ;
+    using extents_type = Extents ;
+    using layout_type = layout_right_padded ;
+
+    constexpr mapping() noexcept : mapping( Extents() ) {}
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    constexpr mapping( const Extents & ext ) noexcept
+      : mapping( ext, PaddingValue == dynamic_extent ? ext.extent(last_rank) : index_type(PaddingValue) ) {}
+
+    // pad must equal padding_value unless padding_value is dynamic_extent
+    constexpr mapping( const Extents & ext, index_type pad ) noexcept
+      : m_extents( ext ), m_strides()
+      {
+        index_type stride_ = index_type( detail::static_extents_product( static_extents, dynamic_strides+1, Extents::rank() ) );
+        for(size_t r = dynamic_strides; r>0; r--) {
+          stride_ *= r == last_rank ? detail::least_multiple_at_least( pad, m_extents.extent(last_rank) )
+                                    : m_extents.extent(r);
+          m_strides[r-1] = stride_;
+        }
+      }
+
+    template<class OtherExtents>
+    constexpr mapping( const layout_right::mapping<OtherExtents> & other ) noexcept
+      : mapping( Extents( other.extents() ) ) {}
+
+    // Preconditions: other.stride(rank-1) == 1 and
+    // other.stride(r) == other.stride(rank-2) * extent(r+1) * ... * extent(rank-2)
+    template<class OtherExtents>
+    explicit constexpr mapping( const layout_stride::mapping<OtherExtents> & other ) noexcept
+      : mapping( Extents( other.extents() ), Extents::rank() > 1 ? index_type( other.stride(Extents::rank()-2) ) : index_type(1) ) {}
+
+    template<class OtherMapping,
+             typename enable_if<detail::is_layout_right_padded<typename OtherMapping::layout_type>::value,int>::type = 0>
+    constexpr mapping( const OtherMapping & other ) noexcept
+      : mapping( Extents( other.extents() ), Extents::rank() > 1 ? index_type( other.stride(Extents::rank()-2) ) : index_type(1) ) {}
+
+    // layout_right and layout_left coincide for rank < 2
+    template<class OtherExtents, size_t Rank = Extents::rank(),
+             typename enable_if<( Rank < 2 ),int>::type = 0>
+    constexpr mapping( const layout_left::mapping<OtherExtents> & other ) noexcept
+      : mapping( Extents( other.extents() ) ) {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+  private:
+
+    template<size_t R>
+    constexpr index_type static_or_cached_stride() const noexcept {
+      if constexpr ( R < dynamic_strides ) return m_strides[R];
+      else return static_strides[R];
+    }
+
+    // i0 * S0 + ... + i(n-1) * S(n-1) + in , with S(n-1) >= Nn and S(r) = N(r+1) * ... * N(n-1) * S(n-1)
+
+    template<size_t ... R, class ... Indices >
+    constexpr index_type
+    offset( index_sequence<R...>, Indices... indices ) const noexcept
+      { return ( index_type(0) + ... + ( index_type(indices) * static_or_cached_stride<R>() ) ); }
+
+  public:
+
+    constexpr index_type required_span_size() const noexcept {
+      if constexpr ( Extents::rank() == 0 ) return 1;
+      else if constexpr ( Extents::rank() == 1 ) return m_extents.extent(0);
+      else {
+        // offset of the last element plus one, zero if any extent is zero
+        const index_type size = static_or_cached_stride<0>() * m_extents.extent(0);
+        return size == 0 ? 0 : size - static_or_cached_stride<last_rank-1>() + m_extents.extent(last_rank);
+      }
+    }
+
+    template<class ... Indices >
+    constexpr
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    operator()( Indices ... indices ) const noexcept
+      { return offset( make_index_sequence<sizeof...(Indices)>(), indices... ); }
+
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept {
+      return Extents::rank() < 2 ||
+             ( static_padding_stride != dynamic_extent && static_padding_stride == Extents::static_extent(last_rank) );
+    }
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept {
+      if constexpr ( Extents::rank() < 2 ) return true ;
+      else return static_or_cached_stride<last_rank-1>() == m_extents.extent(last_rank) ;
+    }
+    constexpr bool is_strided()    const noexcept { return true ; }
+
+    constexpr index_type stride(const size_t R) const noexcept {
+      if constexpr ( dynamic_strides > 0 ) {
+        if ( R < dynamic_strides ) return m_strides[R];
+      }
+      return static_strides[R];
+    }
+
+  }; // class mapping
+
+}; // class layout_right_padded
+
+}}} // experimental::fundamentals_v3
@@ -0,0 +1,235 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <cstddef> // std::ptrdiff_t
+#include <utility> // std::move
+#include <type_traits> // std::enable_if
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace detail {
+
+  // Fully static contiguous arrays are stored in a std::array,
+  // everything else in a std::vector.
+  template<class ElementType, class Extents, class LayoutPolicy,
+           bool Static = Extents::rank_dynamic() == 0 &&
+                         LayoutPolicy::template mapping<Extents>::is_always_contiguous()>
+  struct default_container_policy {
+    using type = vector_container_policy<ElementType> ;
+  };
+
+  template<class ElementType, class Extents, class LayoutPolicy>
+  struct default_container_policy<ElementType,Extents,LayoutPolicy,true> {
+    using type = array_container_policy<ElementType,
+      size_t( static_extents_product( static_extents_of<Extents>(), 0, Extents::rank() ) )> ;
+  };
+
+} // namespace detail
+
+// [mdarray.basic]
+template<class ElementType,
+         class Extents,
+         class LayoutPolicy = layout_right,
+         class ContainerPolicy = typename detail::default_container_policy<ElementType,Extents,LayoutPolicy>::type >
+class basic_mdarray {
+public:
+
+  // Domain and codomain types
+
+  using extents_type          = Extents ;
+  using layout_type           = LayoutPolicy ;
+  using container_policy_type = ContainerPolicy ;
+  using container_type        = typename container_policy_type::container_type ;
+  using mapping_type          = typename layout_type::template mapping<extents_type> ;
+  using element_type          = typename container_policy_type::element_type ;
+  using value_type            = typename remove_cv<element_type>::type ;
+  using index_type            = typename extents_type::index_type ;
+  using difference_type       = ptrdiff_t ;
+  using pointer               = typename container_policy_type::pointer ;
+  using const_pointer         = typename container_policy_type::const_pointer ;
+  using reference             = typename container_policy_type::reference ;
+  using const_reference       = typename container_policy_type::const_reference ;
+  using mdspan_type           = basic_mdspan<element_type,extents_type,layout_type,
+                                             typename container_policy_type::accessor_policy> ;
+  using const_mdspan_type     = basic_mdspan<const element_type,extents_type,layout_type,
+                                             typename container_policy_type::const_accessor_policy> ;
+
+  // [mdarray.basic.cons]
+
+  constexpr basic_mdarray() : basic_mdarray( mapping_type() ) {}
+
+  constexpr basic_mdarray( basic_mdarray && ) = default ;
+
+  constexpr basic_mdarray( const basic_mdarray & ) = default ;
+
+  basic_mdarray & operator = ( basic_mdarray && ) = default ;
+
+  basic_mdarray & operator = ( const basic_mdarray & ) = default ;
+
+  template<class... IndexType ,
+           typename enable_if<( sizeof...(IndexType) > 0 ) &&
+                              ( is_convertible<IndexType,index_type>::value && ... ),int>::type = 0 >
+  explicit constexpr basic_mdarray( IndexType ... DynamicExtents )
+    : basic_mdarray( mapping_type( extents_type( DynamicExtents... ) ) ) {}
+
+  explicit constexpr basic_mdarray( const extents_type & e )
+    : basic_mdarray( mapping_type( e ) ) {}
+
+  explicit constexpr basic_mdarray( const mapping_type & m )
+    : basic_mdarray( m , container_policy_type() ) {}
+
+  constexpr basic_mdarray( const mapping_type & m , const container_policy_type & cp )
+    : map_( m ), cp_( cp ), c_( cp_.create( size_t( map_.required_span_size() ) ) ) {}
+
+  // Allocator aware construction, for policies constructible from an allocator
+  template<class Alloc ,
+           typename enable_if<is_constructible<container_policy_type,const Alloc &>::value &&
+                              !is_same<Alloc,container_policy_type>::value,int>::type = 0 >
+  constexpr basic_mdarray( const mapping_type & m , const Alloc & a )
+    : basic_mdarray( m , container_policy_type( a ) ) {}
+
+  template<class Alloc ,
+           typename enable_if<is_constructible<container_policy_type,const Alloc &>::value,int>::type = 0 >
+  constexpr basic_mdarray( const extents_type & e , const Alloc & a )
+    : basic_mdarray( mapping_type( e ) , container_policy_type( a ) ) {}
+
+  // Requires c.size() >= m.required_span_size()
+  constexpr basic_mdarray( const container_type & c , const mapping_type & m ,
+                           const container_policy_type & cp = container_policy_type() )
+    : map_( m ), cp_( cp ), c_( c ) {}
+
+  constexpr basic_mdarray( container_type && c , const mapping_type & m ,
+                           const container_policy_type & cp = container_policy_type() )
+    : map_( m ), cp_( cp ), c_( std::move( c ) ) {}
+
+  // [mdarray.basic.mapping]
+
+  template<class... IndexType >
+  constexpr typename enable_if<sizeof...(IndexType)==extents_type::rank(),reference>::type
+  operator()( IndexType... indices ) noexcept
+    { return cp_.access( c_ , map_( indices... ) ); }
+
+  template<class... IndexType >
+  constexpr typename enable_if<sizeof...(IndexType)==extents_type::rank(),const_reference>::type
+  operator()( IndexType... indices ) const noexcept
+    { return cp_.access( c_ , map_( indices... ) ); }
+
+  template<class IndexType>
+  constexpr typename enable_if<is_integral<IndexType>::value && 1==extents_type::rank(),reference>::type
+  operator[]( const IndexType i ) noexcept
+    { return cp_.access( c_ , map_(i) ); }
+
+  template<class IndexType>
+  constexpr typename enable_if<is_integral<IndexType>::value && 1==extents_type::rank(),const_reference>::type
+  operator[]( const IndexType i ) const noexcept
+    { return cp_.access( c_ , map_(i) ); }
+
+  // [mdarray.basic.domobs]
+
+  static constexpr int rank() noexcept
+    { return extents_type::rank(); }
+
+  static constexpr int rank_dynamic() noexcept
+    { return extents_type::rank_dynamic(); }
+
+  static constexpr ptrdiff_t static_extent( size_t k ) noexcept
+    { return extents_type::static_extent( k ); }
+
+  constexpr index_type extent( int k ) const noexcept
+    { return map_.extents().extent( k ); }
+
+  constexpr const extents_type & extents() const noexcept
+    { return map_.extents(); }
+
+  // [mdarray.basic.obs]
+
+  static constexpr bool is_always_unique()     noexcept { return mapping_type::is_always_unique(); }
+  static constexpr bool is_always_strided()    noexcept { return mapping_type::is_always_strided(); }
+  static constexpr bool is_always_contiguous() noexcept { return mapping_type::is_always_contiguous(); }
+
+  constexpr bool is_unique() const noexcept  { return map_.is_unique(); }
+  constexpr bool is_strided() const noexcept { return map_.is_strided(); }
+  constexpr bool is_contiguous() const noexcept {return map_.is_contiguous();}
+
+  constexpr index_type stride( size_t r ) const noexcept
+    { return map_.stride(r); }
+
+  constexpr const mapping_type & mapping() const noexcept { return map_ ; }
+
+  constexpr const container_policy_type & container_policy() const noexcept { return cp_ ; }
+
+  constexpr const container_type & container() const noexcept { return c_ ; }
+
+  constexpr pointer data() noexcept { return c_.data() ; }
+
+  constexpr const_pointer data() const noexcept { return c_.data() ; }
+
+  // [mdarray.basic.mdspan]
+  // Non owning views of the data, no copy involved.
+
+  constexpr mdspan_type to_mdspan() noexcept
+    { return mdspan_type( data() , map_ , cp_.make_accessor_policy() ); }
+
+  constexpr const_mdspan_type to_mdspan() const noexcept
+    { return const_mdspan_type( data() , map_ , cp_.make_const_accessor_policy() ); }
+
+  constexpr operator mdspan_type() noexcept { return to_mdspan(); }
+
+  constexpr operator const_mdspan_type() const noexcept { return to_mdspan(); }
+
+private:
+
+  mapping_type map_ ;
+  container_policy_type cp_ ;
+  container_type c_ ;
+};
+
+
+template<class T, ptrdiff_t... Indices>
+using mdarray = basic_mdarray<T,extents<Indices...> > ;
+
+}}} // experimental::fundamentals_v3
@@ -41,7 +41,7 @@
 // ************************************************************************
 //@HEADER
 
-
+#include <cassert> // assert
 
 //--------------------------------------------------------------------------
 //--------------------------------------------------------------------------
@@ -65,6 +65,22 @@ class all_type { public: constexpr explicit all_type() = default; };
 
 /* inline */ constexpr all_type all ;
 
+// Selects the indices offset, offset + stride, ... in [offset,offset+extent).
+// Extent and stride may be integral_constant for a static subspan extent.
+template<class OffsetType, class ExtentType, class StrideType>
+struct strided_slice {
+  using offset_type = OffsetType ;
+  using extent_type = ExtentType ;
+  using stride_type = StrideType ;
+
+  OffsetType offset{} ;
+  ExtentType extent{} ;
+  StrideType stride{} ;
+};
+
+template<class OffsetType, class ExtentType, class StrideType>
+strided_slice( OffsetType, ExtentType, StrideType ) -> strided_slice<OffsetType,ExtentType,StrideType> ;
+
 }}} // experimental::fundamentals_v3
 
 
@@ -89,7 +105,7 @@ public:
   using mapping_type     = typename layout_type::template mapping<extents_type> ;
   using element_type     = typename accessor_type::element_type ;
   using value_type       = typename remove_cv<element_type>::type ;
-  using index_type       = ptrdiff_t ;
+  using index_type       = typename extents_type::index_type ;
   using difference_type  = ptrdiff_t ;
   using pointer          = typename accessor_type::pointer;
   using reference        = typename accessor_type::reference;
@@ -109,41 +125,68 @@ public:
   template<class OtherElementType,
            class OtherExtents,
            class OtherLayoutPolicy,
-           class OtherAccessor>
+           class OtherAccessor,
+           typename enable_if<is_convertible<OtherAccessor,accessor_type>::value,int>::type = 0>
   constexpr basic_mdspan(
     const basic_mdspan<OtherElementType,
                        OtherExtents,
                        OtherLayoutPolicy,
                        OtherAccessor> & rhs ) noexcept
-    : acc_( rhs.acc_ )
-    , map_( rhs.map_ )
-    , ptr_( rhs.ptr_ )
-    {}
+    : acc_( rhs.accessor() )
+    , map_( rhs.mapping() )
+    , ptr_( rhs.data() )
+    { assert( detail::is_valid_data_handle( acc_ , ptr_ ) ); }
+
+  // Explicit if the accessor conversion has preconditions on the data,
+  // e.g. accessor_basic to aligned_accessor.
+  template<class OtherElementType,
+           class OtherExtents,
+           class OtherLayoutPolicy,
+           class OtherAccessor,
+           typename enable_if<!is_convertible<OtherAccessor,accessor_type>::value,int>::type = 0>
+  explicit constexpr basic_mdspan(
+    const basic_mdspan<OtherElementType,
+                       OtherExtents,
+                       OtherLayoutPolicy,
+                       OtherAccessor> & rhs ) noexcept
+    : acc_( rhs.accessor() )
+    , map_( rhs.mapping() )
+    , ptr_( rhs.data() )
+    { assert( detail::is_valid_data_handle( acc_ , ptr_ ) ); }
 
   template<class OtherElementType,
            class OtherExtents,
            class OtherLayoutPolicy,
-           class OtherAccessor>
+           class OtherAccessor,
+           typename enable_if<is_convertible<OtherAccessor,accessor_type>::value,int>::type = 0>
   basic_mdspan & operator = (
     const basic_mdspan<OtherElementType,
                        OtherExtents,
                        OtherLayoutPolicy,
                        OtherAccessor> & rhs ) noexcept
-    { acc_ = rhs.acc_ ; map_ = rhs.map_ ; ptr_ = rhs.ptr_ ; return *this ; }
+    {
+      acc_ = rhs.accessor() ; map_ = rhs.mapping() ; ptr_ = rhs.data() ;
+      assert( detail::is_valid_data_handle( acc_ , ptr_ ) );
+      return *this ;
+    }
 
   template<class... IndexType >
   explicit constexpr basic_mdspan
     ( pointer ptr , IndexType ... DynamicExtents ) noexcept
-    : acc_(accessor_type()), map_( extents_type(DynamicExtents...) ), ptr_(ptr) {}
+    : acc_(accessor_type()), map_( extents_type(DynamicExtents...) ), ptr_(ptr)
+    { assert( detail::is_valid_data_handle( acc_ , ptr_ ) ); }
 
-  constexpr basic_mdspan( pointer ptr , const array<ptrdiff_t,extents_type::rank_dynamic()> dynamic_extents)
-    : acc_(accessor_type()), map_( extents_type(dynamic_extents)), ptr_(ptr) {}
+  constexpr basic_mdspan( pointer ptr , const array<index_type,extents_type::rank_dynamic()> dynamic_extents)
+    : acc_(accessor_type()), map_( extents_type(dynamic_extents)), ptr_(ptr)
+    { assert( detail::is_valid_data_handle( acc_ , ptr_ ) ); }
 
   constexpr basic_mdspan( pointer ptr , const mapping_type m ) noexcept
-    : acc_(accessor_type()), map_( m ), ptr_(ptr) {}
+    : acc_(accessor_type()), map_( m ), ptr_(ptr)
+    { assert( detail::is_valid_data_handle( acc_ , ptr_ ) ); }
   
   constexpr basic_mdspan( pointer ptr , const mapping_type m , const accessor_type a ) noexcept
-    : acc_(a), map_( m ), ptr_(ptr) {}
+    : acc_(a), map_( m ), ptr_(ptr)
+    { assert( detail::is_valid_data_handle( acc_ , ptr_ ) ); }
 
   // [mdspan.basic.mapping]
 
@@ -167,7 +210,7 @@ public:
   static constexpr int rank_dynamic() noexcept
     { return extents_type::rank_dynamic(); }
 
-  static constexpr index_type static_extent( size_t k ) noexcept
+  static constexpr ptrdiff_t static_extent( size_t k ) noexcept
     { return extents_type::static_extent( k ); }
 
   constexpr index_type extent( int k ) const noexcept
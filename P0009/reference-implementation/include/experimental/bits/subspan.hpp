@@ -49,12 +49,38 @@ namespace experimental {
 inline namespace fundamentals_v3 {
 namespace detail {
 
+template<class T>
+struct is_integral_constant : false_type {};
+
+template<class T, T V>
+struct is_integral_constant<integral_constant<T,V>> : integral_constant<bool,!is_same<T,bool>::value> {};
+
+// Number of indices selected by a strided_slice
+constexpr ptrdiff_t strided_slice_extent( ptrdiff_t extent, ptrdiff_t stride ) noexcept {
+  return extent == 0 ? 0 : 1 + ( extent - 1 ) / stride;
+}
+
+template<class ExtentType, class StrideType>
+constexpr ptrdiff_t strided_slice_static_extent() noexcept {
+  if constexpr ( is_integral_constant<ExtentType>::value && is_integral_constant<StrideType>::value )
+    return strided_slice_extent( ExtentType::value, StrideType::value );
+  else return dynamic_extent;
+}
+
+// A pair of integral_constant bounds gives a static sub extent
+template<class IT0, class IT1>
+constexpr ptrdiff_t pair_static_extent() noexcept {
+  if constexpr ( is_integral_constant<IT0>::value && is_integral_constant<IT1>::value )
+    return ptrdiff_t(IT1::value) - ptrdiff_t(IT0::value);
+  else return dynamic_extent;
+}
+
 template<class ExtentsNew, class ExtentsOld, class ... SliceSpecifiers>
 struct compose_new_extents;
 
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
-struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,all_type,SliceSpecifiers...> {
-  typedef compose_new_extents<extents<ExtentsNew...,E0>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+template<class IndexType, ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
+struct compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType,E0,ExtentsOld...>,all_type,SliceSpecifiers...> {
+  typedef compose_new_extents<basic_extents<IndexType,ExtentsNew...,E0>,basic_extents<IndexType,ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
   typedef typename next_compose_new_extents::extents_type extents_type; 
 
   template<class OrgExtents, class ... DynamicExtents>
@@ -65,9 +91,9 @@ struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,all_
     return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
   }
 };
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
-struct compose_new_extents<extents<ExtentsNew...>,extents<dynamic_extent,ExtentsOld...>,all_type,SliceSpecifiers...> {
-  typedef compose_new_extents<extents<ExtentsNew...,dynamic_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+template<class IndexType, ptrdiff_t ... ExtentsNew, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
+struct compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType,dynamic_extent,ExtentsOld...>,all_type,SliceSpecifiers...> {
+  typedef compose_new_extents<basic_extents<IndexType,ExtentsNew...,dynamic_extent>,basic_extents<IndexType,ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
   typedef typename next_compose_new_extents::extents_type extents_type; 
 
   template<class OrgExtents, class ... DynamicExtents>
@@ -79,23 +105,48 @@ struct compose_new_extents<extents<ExtentsNew...>,extents<dynamic_extent,Extents
   }
 };
 
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
-struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,pair<IT,IT>,SliceSpecifiers...> {
-  typedef compose_new_extents<extents<ExtentsNew...,dynamic_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents; 
+template<class IndexType, ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT0, class IT1, class ... SliceSpecifiers>
+struct compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType,E0,ExtentsOld...>,pair<IT0,IT1>,SliceSpecifiers...> {
+  static constexpr ptrdiff_t sub_extent = pair_static_extent<IT0,IT1>();
+  typedef compose_new_extents<basic_extents<IndexType,ExtentsNew...,sub_extent>,basic_extents<IndexType,ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents; 
   typedef typename next_compose_new_extents::extents_type extents_type; 
 
   template<class OrgExtents, class ... DynamicExtents>
   static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
-                                                   pair<IT,IT> p, SliceSpecifiers ... s, DynamicExtents...de) {
+                                                   pair<IT0,IT1> p, SliceSpecifiers ... s, DynamicExtents...de) {
     strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
-    offset += p.first*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
-    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,ptrdiff_t(p.second-p.first));
+    offset += ptrdiff_t(p.first)*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+    if constexpr ( sub_extent == dynamic_extent )
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,ptrdiff_t(p.second)-ptrdiff_t(p.first));
+    else
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
   }
 };
 
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
-struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,IT,SliceSpecifiers...> {
-  typedef compose_new_extents<extents<ExtentsNew...>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+template<class IndexType, ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class OT, class ET, class ST, class ... SliceSpecifiers>
+struct compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType,E0,ExtentsOld...>,strided_slice<OT,ET,ST>,SliceSpecifiers...> {
+  static constexpr ptrdiff_t sub_extent = strided_slice_static_extent<ET,ST>();
+  typedef compose_new_extents<basic_extents<IndexType,ExtentsNew...,sub_extent>,basic_extents<IndexType,ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+  typedef typename next_compose_new_extents::extents_type extents_type;
+
+  template<class OrgExtents, class ... DynamicExtents>
+  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
+                                                   strided_slice<OT,ET,ST> p, SliceSpecifiers ... s, DynamicExtents...de) {
+    const ptrdiff_t extent = ptrdiff_t(p.extent);
+    const ptrdiff_t stride = ptrdiff_t(p.stride);
+    offset += ptrdiff_t(p.offset)*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+    strides[sizeof...(ExtentsNew)] = stride < extent ? stride*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1]
+                                                     : strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+    if constexpr ( sub_extent == dynamic_extent )
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,strided_slice_extent(extent,stride));
+    else
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
+  }
+};
+
+template<class IndexType, ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
+struct compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType,E0,ExtentsOld...>,IT,SliceSpecifiers...> {
+  typedef compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType,ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
   typedef typename next_compose_new_extents::extents_type extents_type; 
 
   template<class OrgExtents, class ... DynamicExtents>
@@ -106,9 +157,9 @@ struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,IT,S
   }
 };
 
-template<ptrdiff_t ... ExtentsNew>
-struct compose_new_extents<extents<ExtentsNew...>,extents<>> {
-  typedef extents<ExtentsNew...> extents_type; 
+template<class IndexType, ptrdiff_t ... ExtentsNew>
+struct compose_new_extents<basic_extents<IndexType,ExtentsNew...>,basic_extents<IndexType>> {
+  typedef basic_extents<IndexType,ExtentsNew...> extents_type; 
 
   template<class OrgExtents, class ... DynamicExtents>
   static constexpr extents_type create_sub_extents(const OrgExtents, array<ptrdiff_t,OrgExtents::rank()>, ptrdiff_t, DynamicExtents...de) {
@@ -123,23 +174,160 @@ struct compose_new_extents<extents<ExtentsNew...>,extents<>> {
 
 template<class Extents, class...SliceSpecifiers>
 struct subspan_deduce_extents {
-  typedef typename compose_new_extents<extents<>,Extents,SliceSpecifiers...>::extents_type extents_type;
+  typedef typename compose_new_extents<basic_extents<typename Extents::index_type>,Extents,SliceSpecifiers...>::extents_type extents_type;
   typedef array<ptrdiff_t,Extents::rank()> stride_type;
   static constexpr extents_type create_sub_extents(const Extents e,stride_type& strides, ptrdiff_t& offset, SliceSpecifiers...s) {
-    return compose_new_extents<extents<>,Extents,SliceSpecifiers...>::create_sub_extents(e,strides,offset,s...);
+    return compose_new_extents<basic_extents<typename Extents::index_type>,Extents,SliceSpecifiers...>::create_sub_extents(e,strides,offset,s...);
   }
 };
 
+// Layout of a subspan.
+//
+// Slices of layout_left / layout_right mappings that keep the leading
+// (resp. trailing) ranks, all full except the innermost kept one, stay
+// contiguous and keep the layout. Slices of these layouts and their padded
+// variants that keep rank 0 (resp. rank-1) and one block of consecutive
+// ranks are padded layouts. Everything else is layout_stride.
+
+enum class slice_kind { index, range, full, strided };
+
+template<class Slice>
+struct slice_kind_of { static constexpr slice_kind value = slice_kind::index; };
+
+template<>
+struct slice_kind_of<all_type> { static constexpr slice_kind value = slice_kind::full; };
+
+template<class IT0, class IT1>
+struct slice_kind_of<pair<IT0,IT1>> { static constexpr slice_kind value = slice_kind::range; };
+
+template<class OT, class ET, class ST>
+struct slice_kind_of<strided_slice<OT,ET,ST>> { static constexpr slice_kind value = slice_kind::strided; };
+
+template<size_t N>
+constexpr array<slice_kind,N> reversed_slice_kinds( const array<slice_kind,N>& k ) noexcept {
+  array<slice_kind,N> rk{};
+  for(size_t r = 0; r<N; r++) rk[r] = k[N-1-r];
+  return rk;
+}
+
+// For slices given in layout_left order, returns the first kept rank p > 0
+// if the subspan is layout_left_padded, 0 if it is layout_left and N if it
+// is only layout_stride.
+// The subspan is padded if rank 0 is kept and the other kept ranks are
+// [p,p+m), all full except the last which may be a range.
+// Strided slices always give layout_stride.
+template<size_t N>
+constexpr size_t padded_subspan_rank( const array<slice_kind,N>& k ) noexcept {
+  size_t sub_rank = 0;
+  for(size_t r = 0; r<N; r++) {
+    if(k[r] == slice_kind::strided) return N;
+    if(k[r] != slice_kind::index) sub_rank++;
+  }
+  if(sub_rank == 0) return 0;
+  if(k[0] == slice_kind::index) return N;
+  if(sub_rank == 1) return 0;
+  size_t p = 1;
+  while(k[p] == slice_kind::index) p++;
+  for(size_t r = p; r<p+sub_rank-2; r++)
+    if(k[r] != slice_kind::full) return N;
+  return k[p+sub_rank-2] != slice_kind::index ? p : N;
+}
+
+constexpr ptrdiff_t static_product( ptrdiff_t a, ptrdiff_t b ) noexcept {
+  return a == dynamic_extent || b == dynamic_extent ? dynamic_extent : a*b;
+}
+
+template<class ... SliceSpecifiers>
+struct slice_kinds {
+  static constexpr size_t rank = sizeof...(SliceSpecifiers);
+  static constexpr array<slice_kind,rank> left{{ slice_kind_of<SliceSpecifiers>::value... }};
+  static constexpr array<slice_kind,rank> right = reversed_slice_kinds( left );
+
+  static constexpr size_t left_padded_rank = padded_subspan_rank( left );
+  static constexpr size_t right_padded_rank = padded_subspan_rank( right );
+
+  // the kept ranks are [0,m) resp. [rank-m,rank) and the source stays contiguous
+  static constexpr bool left_contiguous = left_padded_rank == 1 && left[0] == slice_kind::full;
+  static constexpr bool right_contiguous = right_padded_rank == 1 && right[0] == slice_kind::full;
+};
+
+// P is padded_subspan_rank of the slices in layout_left order (reversed for
+// the right layouts) and SubPadding the static padding stride of a padded
+// result, which is the source stride(P) (resp. stride(N-1-P)). That stride
+// is 0 if one of the extents it multiplies is statically 0, which is not a
+// valid padding value, so the result is then padded dynamically.
+template<bool Right, size_t N, size_t P, bool Contiguous, ptrdiff_t SubPadding>
+struct padded_subspan_layout {
+  static constexpr ptrdiff_t padding_value = SubPadding == 0 ? dynamic_extent : SubPadding;
+  typedef typename conditional<Right, layout_right, layout_left>::type contiguous_layout;
+  typedef typename conditional<Right, layout_right_padded<padding_value>, layout_left_padded<padding_value>>::type padded_layout;
+
+  typedef typename conditional<P == 0 || Contiguous, contiguous_layout,
+          typename conditional<P == N, layout_stride, padded_layout>::type>::type type;
+
+  template<class SubExtents>
+  static typename type::template mapping<SubExtents>
+  create_mapping(const SubExtents& e, const array<typename SubExtents::index_type,SubExtents::rank()>& strides) {
+    if constexpr ( P == 0 || Contiguous ) return typename type::template mapping<SubExtents>(e);
+    else if constexpr ( P == N ) return typename type::template mapping<SubExtents>(e,strides);
+    else return typename type::template mapping<SubExtents>(e,strides[Right ? SubExtents::rank()-2 : 1]);
+  }
+};
+
+template<class Layout, class Extents, class ... SliceSpecifiers>
+struct subspan_layout {
+  typedef layout_stride type;
+
+  template<class SubExtents>
+  static typename type::template mapping<SubExtents>
+  create_mapping(const SubExtents& e, const array<typename SubExtents::index_type,SubExtents::rank()>& strides) {
+    return typename type::template mapping<SubExtents>(e,strides);
+  }
+};
+
+template<class Extents, class ... SliceSpecifiers>
+struct subspan_layout<layout_left,Extents,SliceSpecifiers...>
+  : padded_subspan_layout<false, Extents::rank(),
+      slice_kinds<SliceSpecifiers...>::left_padded_rank,
+      slice_kinds<SliceSpecifiers...>::left_contiguous,
+      static_extents_product( static_extents_of<Extents>(), 0, slice_kinds<SliceSpecifiers...>::left_padded_rank )> {};
+
+template<class Extents, class ... SliceSpecifiers>
+struct subspan_layout<layout_right,Extents,SliceSpecifiers...>
+  : padded_subspan_layout<true, Extents::rank(),
+      slice_kinds<SliceSpecifiers...>::right_padded_rank,
+      slice_kinds<SliceSpecifiers...>::right_contiguous,
+      static_extents_product( static_extents_of<Extents>(),
+                              Extents::rank()-slice_kinds<SliceSpecifiers...>::right_padded_rank, Extents::rank() )> {};
+
+template<ptrdiff_t PaddingValue, class Extents, class ... SliceSpecifiers>
+struct subspan_layout<layout_left_padded<PaddingValue>,Extents,SliceSpecifiers...>
+  : padded_subspan_layout<false, Extents::rank(),
+      slice_kinds<SliceSpecifiers...>::left_padded_rank, false,
+      static_product( static_padding_stride( PaddingValue, Extents::rank(), Extents::static_extent(0) ),
+                      static_extents_product( static_extents_of<Extents>(), 1, slice_kinds<SliceSpecifiers...>::left_padded_rank ) )> {};
+
+template<ptrdiff_t PaddingValue, class Extents, class ... SliceSpecifiers>
+struct subspan_layout<layout_right_padded<PaddingValue>,Extents,SliceSpecifiers...>
+  : padded_subspan_layout<true, Extents::rank(),
+      slice_kinds<SliceSpecifiers...>::right_padded_rank, false,
+      static_product( static_padding_stride( PaddingValue, Extents::rank(), Extents::static_extent(Extents::rank()-1) ),
+                      static_extents_product( static_extents_of<Extents>(),
+                                              Extents::rank()-slice_kinds<SliceSpecifiers...>::right_padded_rank,
+                                              Extents::rank() > 0 ? Extents::rank()-1 : 0 ) )> {};
+
 }
 
 template<class ElementType, class Extents, class LayoutPolicy,
            class AccessorPolicy, class... SliceSpecifiers>
     basic_mdspan<ElementType, typename detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::extents_type,
-                 layout_stride, typename AccessorPolicy::offset_policy >
+                 typename detail::subspan_layout<LayoutPolicy,Extents,SliceSpecifiers...>::type,
+                 typename AccessorPolicy::offset_policy >
       subspan(const basic_mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src, SliceSpecifiers ... slices) noexcept {
     typedef typename detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::extents_type sub_extents_type;
+    typedef detail::subspan_layout<LayoutPolicy,Extents,SliceSpecifiers...> sub_layout;
     typedef typename AccessorPolicy::offset_policy sub_accessor_policy;
-    typedef basic_mdspan<ElementType,sub_extents_type,layout_stride,sub_accessor_policy> sub_mdspan_type;
+    typedef basic_mdspan<ElementType,sub_extents_type,typename sub_layout::type,sub_accessor_policy> sub_mdspan_type;
 
     array<ptrdiff_t,Extents::rank()> strides;
     for(size_t r = 0; r<Extents::rank(); r++)
@@ -148,12 +336,12 @@ template<class ElementType, class Extents, class LayoutPolicy,
     ptrdiff_t offset = 0;
     sub_extents_type sub_extents = detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::create_sub_extents(src.extents(),strides,offset,slices...);
 
-    array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
+    array<typename sub_extents_type::index_type,sub_extents_type::rank()> sub_strides;
     for(size_t r = 0; r<sub_extents_type::rank(); r++)
-      sub_strides[r] = strides[r];
+      sub_strides[r] = typename sub_extents_type::index_type(strides[r]);
 
     typename AccessorPolicy::offset_policy::pointer ptr = src.accessor().offset(src.data(),offset);    
-    return sub_mdspan_type(ptr,typename sub_mdspan_type::mapping_type(sub_extents,sub_strides));
+    return sub_mdspan_type(ptr,sub_layout::create_mapping(sub_extents,sub_strides));
   }
 
 }}}
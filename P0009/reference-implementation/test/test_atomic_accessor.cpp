@@ -0,0 +1,309 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include<experimental/atomic_accessor>
+#include<thread>
+#include<vector>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class atomic_accessor_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+TEST_F(atomic_accessor_,types) {
+  ASSERT_TRUE((std::is_same<atomic_accessor<int>::reference,Foo::atomic_ref<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor_relaxed<int>::reference,Foo::atomic_ref_relaxed<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor_acq_rel<int>::reference,Foo::atomic_ref_acq_rel<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor_seq_cst<int>::reference,Foo::atomic_ref_seq_cst<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor<int>::offset_policy,atomic_accessor<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor<int>::pointer,int*>::value));
+  ASSERT_TRUE((std::is_trivially_copyable<atomic_accessor_relaxed<double>>::value));
+  ASSERT_TRUE((std::is_convertible<accessor_basic<int>,atomic_accessor_relaxed<int>>::value));
+  ASSERT_FALSE((std::is_convertible<atomic_accessor_relaxed<int>,accessor_basic<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor_bound<int,std::memory_order_relaxed>,atomic_accessor_relaxed<int>>::value));
+  ASSERT_TRUE((std::is_same<atomic_accessor_bound<int,std::memory_order_release>::reference,Foo::atomic_ref_bound<int,std::memory_order_release>>::value));
+  ASSERT_EQ(Foo::atomic_ref_relaxed<int>::memory_ordering,std::memory_order_relaxed);
+}
+
+TEST_F(atomic_accessor_,misaligned_data_handle) {
+  typedef basic_mdspan<int,extents<dynamic_extent>,layout_right,atomic_accessor<int>> mdspan_atomic_type;
+  ASSERT_GT(Foo::atomic_ref<int>::required_alignment,1u);
+
+  alignas(int) char buf[5*sizeof(int)] = {};
+  int* aligned = reinterpret_cast<int*>(buf);
+  int* misaligned = reinterpret_cast<int*>(buf+1);
+  ASSERT_TRUE(atomic_accessor<int>::is_sufficiently_aligned(aligned));
+  ASSERT_FALSE(atomic_accessor<int>::is_sufficiently_aligned(misaligned));
+
+  mdspan_atomic_type a(aligned,4);
+  ASSERT_EQ(a.extent(0),4);
+  EXPECT_DEBUG_DEATH(mdspan_atomic_type(misaligned,4),"is_valid_data_handle");
+}
+
+TEST_F(atomic_accessor_,access) {
+  typedef basic_mdspan<int,extents<dynamic_extent,4>,layout_right,accessor_basic<int>> mdspan_type;
+  typedef basic_mdspan<int,extents<dynamic_extent,4>,layout_right,atomic_accessor_acq_rel<int>> mdspan_atomic_type;
+
+  int data[3*4] = {};
+  mdspan_type a(data,3);
+  mdspan_atomic_type b(a);
+  ASSERT_EQ(b.data(),data);
+
+  b(1,2) = 5;
+  ASSERT_EQ(data[6],5);
+  ASSERT_EQ(b(1,2) += 3,8);
+  ASSERT_EQ(b(1,2)++,8);
+  ASSERT_EQ(--b(1,2),8);
+  ASSERT_EQ(b(1,2) |= 16,24);
+  ASSERT_EQ(b(1,2) &= 17,16);
+  ASSERT_EQ(b(1,2).exchange(1),16);
+  int expected = 1;
+  ASSERT_TRUE(b(1,2).compare_exchange_strong(expected,2));
+  ASSERT_EQ(int(b(1,2)),2);
+  ASSERT_EQ(a(1,2),2);
+
+  auto sub = subspan(b,2,all);
+  ASSERT_TRUE((std::is_same<decltype(sub)::accessor_type,atomic_accessor_acq_rel<int>>::value));
+  sub(3).fetch_add(7);
+  ASSERT_EQ(data[11],7);
+}
+
+TEST_F(atomic_accessor_,floating_point) {
+  double data[4] = {};
+  basic_mdspan<double,extents<4>,layout_right,atomic_accessor<double>> a(data);
+  a(1) += 1.5;
+  a(1) -= 0.25;
+  ASSERT_EQ(data[1],1.25);
+
+  basic_mdspan<double,extents<4>,layout_right,atomic_accessor_relaxed<double>> b(data);
+  ASSERT_EQ(b(1).fetch_add(1.0),1.25);
+  ASSERT_EQ(b(1).load(),2.25);
+}
+
+TEST_F(atomic_accessor_,histogram) {
+  constexpr int num_threads = 4;
+  constexpr int num_samples = 10000;
+  constexpr int num_bins = 8;
+
+  std::vector<int> bins(num_bins,0);
+  basic_mdspan<int,extents<dynamic_extent,num_bins>,layout_right,atomic_accessor_relaxed<int>> counts(bins.data(),1);
+
+  std::vector<std::thread> threads;
+  for(int t=0; t<num_threads; t++)
+    threads.emplace_back([=]() {
+      for(int i=0; i<num_samples; i++)
+        counts(0,(i*7+t)%num_bins)++;
+    });
+  for(auto& thread: threads)
+    thread.join();
+
+  int total = 0;
+  for(int b=0; b<num_bins; b++)
+    total += bins[b];
+  ASSERT_EQ(total,num_threads*num_samples);
+}
+
+TEST_F(atomic_accessor_,striped_reducer) {
+  typedef striped_reducer<int,extents<dynamic_extent,3>> reducer_type;
+  reducer_type r(layout_right::mapping<extents<dynamic_extent,3>>(extents<dynamic_extent,3>(2)),3);
+  ASSERT_EQ(r.stripes(),4u);
+
+  auto v = r.view();
+  ASSERT_TRUE((std::is_same<decltype(v)::accessor_type,striped_accessor<int>>::value));
+  ASSERT_TRUE((std::is_same<decltype(v)::reference,Foo::atomic_ref_relaxed<int>>::value));
+  ASSERT_EQ(v.accessor().stripes(),4u);
+  ASSERT_EQ(v.accessor().stripe_stride()%16,0);
+
+  v(1,2) += 5;
+  v(0,0)++;
+
+  int data[2*3] = {1,1,1,1,1,1};
+  mdspan<int,dynamic_extent,3> dst(data,2);
+  r.flush(dst);
+  ASSERT_EQ(dst(0,0),2);
+  ASSERT_EQ(dst(0,1),1);
+  ASSERT_EQ(dst(1,2),6);
+
+  // flush resets the stripes
+  r.flush(dst);
+  ASSERT_EQ(dst(1,2),6);
+}
+
+TEST_F(atomic_accessor_,striped_histogram) {
+  constexpr int num_threads = 8;
+  constexpr int num_samples = 10000;
+  constexpr int num_bins = 5;
+
+  striped_reducer<long,extents<num_bins>> r(layout_right::mapping<extents<num_bins>>(),4);
+  auto counts = r.view();
+
+  std::vector<std::thread> threads;
+  for(int t=0; t<num_threads; t++)
+    threads.emplace_back([=]() {
+      for(int i=0; i<num_samples; i++)
+        counts((i+t)%num_bins) += 1;
+    });
+  for(auto& thread: threads)
+    thread.join();
+
+  long bins[num_bins] = {};
+  basic_mdspan<long,extents<num_bins>,layout_right,atomic_accessor_relaxed<long>> dst(bins);
+  r.flush(dst);
+
+  for(int b=0; b<num_bins; b++)
+    ASSERT_EQ(bins[b],long(num_threads*num_samples/num_bins));
+}
+
+TEST_F(atomic_accessor_,wait_notify) {
+  constexpr int n = 16;
+
+  int ready_data[n] = {};
+  int values[n] = {};
+  basic_mdspan<int,extents<n>,layout_right,atomic_accessor_acq_rel<int>> ready(ready_data);
+
+  // each element is produced from its predecessor, consumers sleep on
+  // the completion flag of the element they need
+  std::vector<std::thread> threads;
+  for(int i=1; i<n; i++)
+    threads.emplace_back([=,&values]() {
+      ready(i-1).wait(0);
+      values[i] = values[i-1] + i;
+      ready(i) = 1;
+      ready(i).notify_all();
+    });
+
+  values[0] = 0;
+  ready(0) = 1;
+  ready(0).notify_all();
+
+  for(auto& thread: threads)
+    thread.join();
+  ASSERT_EQ(values[n-1],n*(n-1)/2);
+}
+
+TEST_F(atomic_accessor_,fetch_add_range) {
+  constexpr int num_threads = 4;
+  constexpr int num_rounds = 50;
+  constexpr int n = 1000;
+
+  // Contiguous views of the same layout; n doubles span several chunks
+  // and the destination starts in the middle of one. A plain destination
+  // takes the chunk locked path.
+  std::vector<double> sums(n+3,0.0);
+  basic_mdspan<double,extents<dynamic_extent,4>,layout_right,accessor_basic<double>> dst(sums.data()+3,n/4);
+  std::vector<std::thread> threads;
+  for(int t=0; t<num_threads; t++)
+    threads.emplace_back([=]() {
+      std::vector<double> values(n);
+      for(int i=0; i<n; i++) values[i] = i + 0.5*t;
+      mdspan<double,dynamic_extent,4> src(values.data(),n/4);
+      for(int r=0; r<num_rounds; r++)
+        atomic_fetch_add_range(dst,src);
+    });
+  for(auto& thread: threads)
+    thread.join();
+
+  ASSERT_EQ(sums[0],0.0);
+  for(int i=0; i<n; i++)
+    ASSERT_EQ(sums[i+3],num_rounds*(num_threads*i + 0.5*(0+1+2+3)));
+
+  // A strided column of dst and a layout_left source take the
+  // index by index path
+  int data[5*3] = {};
+  basic_mdspan<int,extents<5,3>,layout_right,accessor_basic<int>> a(data);
+  auto column = subspan(a,all,1);
+  int values[5] = {1,2,3,4,5};
+  basic_mdspan<int,extents<5>,layout_left,accessor_basic<int>> src(values);
+  atomic_fetch_add_range(column,src);
+  atomic_fetch_add_range(column,src);
+  for(int i=0; i<5; i++) {
+    ASSERT_EQ(data[i*3],0);
+    ASSERT_EQ(data[i*3+1],2*(i+1));
+    ASSERT_EQ(data[i*3+2],0);
+  }
+}
+
+template<class Dst, class Src, class = void>
+struct can_fetch_add_range : std::false_type {};
+
+template<class Dst, class Src>
+struct can_fetch_add_range<Dst,Src,
+  decltype(atomic_fetch_add_range(std::declval<const Dst&>(),std::declval<const Src&>()))> : std::true_type {};
+
+TEST_F(atomic_accessor_,fetch_add_range_atomic_view) {
+  typedef basic_mdspan<long,extents<dynamic_extent,8>,layout_right,atomic_accessor_relaxed<long>> atomic_type;
+  typedef basic_mdspan<long,extents<dynamic_extent,8>,layout_right,accessor_basic<long>> plain_type;
+  typedef mdspan<long,dynamic_extent,8> src_type;
+
+  // only plain destinations take bulk updates
+  ASSERT_TRUE((can_fetch_add_range<plain_type,src_type>::value));
+  ASSERT_FALSE((can_fetch_add_range<atomic_type,src_type>::value));
+
+  // accumulate through the plain view of the memory of an atomic view,
+  // then read it through the atomic view
+  constexpr int num_threads = 4;
+  constexpr int n = 64;
+  std::vector<long> sums(n,0);
+  atomic_type a(sums.data(),n/8);
+  plain_type dst(a.accessor().decay(a.data()),a.mapping());
+  std::vector<std::thread> threads;
+  for(int t=0; t<num_threads; t++)
+    threads.emplace_back([=]() {
+      std::vector<long> ones(n,1);
+      src_type src(ones.data(),n/8);
+      for(int r=0; r<100; r++)
+        atomic_fetch_add_range(dst,src);
+    });
+  for(auto& thread: threads)
+    thread.join();
+  for(int i0=0; i0<n/8; i0++)
+  for(int i1=0; i1<8; i1++)
+    ASSERT_EQ(long(a(i0,i1)),100*num_threads);
+}
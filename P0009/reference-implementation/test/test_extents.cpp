@@ -148,3 +148,51 @@ TEST_F(extents_,assignment) {
     ASSERT_EQ(e3.extent(r),e1.extent(r));
 }
 
+
+TEST_F(extents_,compact_storage) {
+  ASSERT_EQ(sizeof(extents<5,dynamic_extent,3,dynamic_extent,1>),2*sizeof(ptrdiff_t));
+  ASSERT_EQ(sizeof(extents<dynamic_extent,dynamic_extent,dynamic_extent>),3*sizeof(ptrdiff_t));
+  ASSERT_TRUE((std::is_empty<extents<5,4,3>>::value));
+  ASSERT_TRUE((std::is_empty<extents<>>::value));
+  ASSERT_TRUE((std::is_trivially_copyable<extents<5,dynamic_extent,3,dynamic_extent,1>>::value));
+  ASSERT_TRUE((std::is_trivially_copyable<extents<5,4,3>>::value));
+}
+
+TEST_F(extents_,constexpr_extent) {
+  constexpr extents<5,dynamic_extent,3,dynamic_extent,1> e(4,2);
+  static_assert(e.extent(0) == 5, "");
+  static_assert(e.extent(1) == 4, "");
+  static_assert(e.extent(2) == 3, "");
+  static_assert(e.extent(3) == 2, "");
+  static_assert(e.extent(4) == 1, "");
+  constexpr extents<dynamic_extent,dynamic_extent,dynamic_extent,dynamic_extent,dynamic_extent> e_dyn(e);
+  static_assert(e_dyn.extent(0) == 5, "");
+  static_assert(e_dyn.extent(3) == 2, "");
+  ASSERT_TRUE(e_dyn == e);
+}
+
+TEST_F(extents_,index_type) {
+  using std::experimental::fundamentals_v3::basic_extents;
+  typedef basic_extents<int32_t,5,dynamic_extent,3,dynamic_extent,1> extents_int32_type;
+  typedef basic_extents<uint32_t,5,dynamic_extent,3,dynamic_extent,1> extents_uint32_type;
+
+  ASSERT_TRUE((std::is_same<extents_int32_type::index_type,int32_t>::value));
+  ASSERT_TRUE((std::is_same<extents_uint32_type::index_type,uint32_t>::value));
+  ASSERT_EQ(sizeof(extents_int32_type),2*sizeof(int32_t));
+  ASSERT_EQ(extents_uint32_type::static_extent(1),dynamic_extent);
+
+  extents_int32_type e_int32(4,2);
+  extents_uint32_type e_uint32(4,2);
+  for(size_t r=0; r<5; r++) {
+    ASSERT_EQ(e_int32.extent(r),int32_t(5-r));
+    ASSERT_EQ(e_uint32.extent(r),uint32_t(5-r));
+  }
+
+  // widening conversions are implicit, narrowing ones explicit
+  extents<5,dynamic_extent,3,dynamic_extent,1> e_ptrdiff = e_int32;
+  ASSERT_TRUE(e_ptrdiff == e_int32);
+  ASSERT_TRUE((std::is_convertible<extents_int32_type,extents<5,dynamic_extent,3,dynamic_extent,1>>::value));
+  ASSERT_FALSE((std::is_convertible<extents<5,dynamic_extent,3,dynamic_extent,1>,extents_int32_type>::value));
+  extents_int32_type e_narrow(e_ptrdiff);
+  ASSERT_TRUE(e_narrow == e_uint32);
+}
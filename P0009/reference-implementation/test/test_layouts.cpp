@@ -49,6 +49,9 @@ using std::experimental::fundamentals_v3::extents;
 using std::experimental::fundamentals_v3::dynamic_extent;
 using std::experimental::fundamentals_v3::layout_right;
 using std::experimental::fundamentals_v3::layout_left;
+using std::experimental::fundamentals_v3::layout_stride;
+using std::experimental::fundamentals_v3::layout_left_padded;
+using std::experimental::fundamentals_v3::layout_right_padded;
 
 class layouts_ : public ::testing::Test {
 protected:
@@ -134,6 +137,7 @@ TEST_F(layouts_,construction_right) {
   test.check_rank_dynamic(2);
   test.check_extents(5,4,3,2,1);
   test.check_strides(24,6,2,1,1);
+  test.check_required_span_size(120);
 
 }
 
@@ -144,6 +148,40 @@ TEST_F(layouts_,construction_left) {
   test.check_rank_dynamic(2);
   test.check_extents(5,4,3,2,1);
   test.check_strides(1,5,20,60,120);
+  test.check_required_span_size(120);
+}
+
+TEST_F(layouts_,static_strides) {
+  test_layouts<layout_right,5,4,3,2,1> test_right;
+  test_right.check_strides(24,6,2,1,1);
+  test_right.check_required_span_size(120);
+
+  test_layouts<layout_left,5,4,3,2,1> test_left;
+  test_left.check_strides(1,5,20,60,120);
+  test_left.check_required_span_size(120);
+
+  static_assert(layout_right::mapping<extents<5,4,3,2,1>>().stride(0) == 24, "");
+  static_assert(layout_left::mapping<extents<5,4,3,2,1>>().stride(4) == 120, "");
+  static_assert(layout_right::mapping<extents<5,4,3,2,1>>()(4,1,2,1,0) == 107, "");
+  static_assert(layout_left::mapping<extents<5,4,3,2,1>>()(4,1,2,1,0) == 109, "");
+}
+
+TEST_F(layouts_,dynamic_strides) {
+  test_layouts<layout_right,dynamic_extent,4,dynamic_extent,2,1> test_right(5,3);
+  test_right.check_strides(24,6,2,1,1);
+  test_right.check_required_span_size(120);
+
+  test_layouts<layout_left,5,dynamic_extent,3,dynamic_extent,1> test_left(4,2);
+  test_left.check_strides(1,5,20,60,120);
+  test_left.check_required_span_size(120);
+
+  test_layouts<layout_right,5,4,3,2,dynamic_extent> test_right_last(1);
+  test_right_last.check_strides(24,6,2,1,1);
+  test_right_last.check_required_span_size(120);
+
+  test_layouts<layout_left,dynamic_extent,4,3,2,1> test_left_first(5);
+  test_left_first.check_strides(1,5,20,60,120);
+  test_left_first.check_required_span_size(120);
 }
 
 TEST_F(layouts_,properties_right) {
@@ -158,6 +196,97 @@ TEST_F(layouts_,properties_left) {
   test.check_properties(true,true,true,true,true,true);
 }
 
+TEST_F(layouts_,construction_left_padded) {
+  test_layouts<layout_left_padded<4>,5,dynamic_extent,3> test(6);
+
+  test.check_rank(3);
+  test.check_rank_dynamic(1);
+  test.check_extents(5,6,3);
+  test.check_strides(1,8,48);
+  test.check_required_span_size(48*3-8+5);
+  test.check_properties(true,false,true,true,false,true);
+
+  test_layouts<layout_left_padded<>,5,dynamic_extent,3> test_dynamic(6);
+  test_dynamic.check_strides(1,5,30);
+  test_dynamic.check_required_span_size(90);
+  test_dynamic.check_properties(true,false,true,true,true,true);
+
+  layout_left_padded<>::mapping<extents<5,dynamic_extent,3>> map(extents<5,dynamic_extent,3>(6),7);
+  ASSERT_EQ(map.stride(1),7);
+  ASSERT_EQ(map.stride(2),42);
+}
+
+TEST_F(layouts_,construction_right_padded) {
+  test_layouts<layout_right_padded<4>,3,dynamic_extent,5> test(6);
+
+  test.check_rank(3);
+  test.check_rank_dynamic(1);
+  test.check_extents(3,6,5);
+  test.check_strides(48,8,1);
+  test.check_required_span_size(48*3-8+5);
+  test.check_properties(true,false,true,true,false,true);
+
+  test_layouts<layout_right_padded<>,3,dynamic_extent,5> test_dynamic(6);
+  test_dynamic.check_strides(30,5,1);
+  test_dynamic.check_required_span_size(90);
+  test_dynamic.check_properties(true,false,true,true,true,true);
+
+  layout_right_padded<>::mapping<extents<3,dynamic_extent,5>> map(extents<3,dynamic_extent,5>(6),7);
+  ASSERT_EQ(map.stride(1),7);
+  ASSERT_EQ(map.stride(0),42);
+}
+
+TEST_F(layouts_,static_strides_padded) {
+  typedef layout_left_padded<4>::mapping<extents<3,4,5>> mapping_left_type;
+  typedef layout_right_padded<4>::mapping<extents<5,4,3>> mapping_right_type;
+
+  static_assert(mapping_left_type().stride(2) == 16, "");
+  static_assert(mapping_right_type().stride(0) == 16, "");
+  static_assert(mapping_left_type()(1,2,3) == 57, "");
+  static_assert(mapping_right_type()(3,2,1) == 57, "");
+  static_assert(mapping_left_type::is_always_contiguous() == false, "");
+  static_assert(layout_left_padded<4>::mapping<extents<8,4>>::is_always_contiguous(), "");
+  static_assert(layout_right_padded<4>::mapping<extents<4,8>>::is_always_contiguous(), "");
+  static_assert(layout_left_padded<4>::mapping<extents<5>>::is_always_contiguous(), "");
+}
+
+TEST_F(layouts_,conversion_padded) {
+  typedef extents<dynamic_extent,4,dynamic_extent> extents_type;
+  extents_type e(3,5);
+
+  layout_left::mapping<extents_type> map_left(e);
+  layout_left_padded<4>::mapping<extents_type> map_left_padded = map_left;
+  ASSERT_EQ(map_left_padded.stride(1),4);
+  ASSERT_EQ(map_left_padded.stride(2),16);
+
+  layout_stride::mapping<extents_type> map_stride(map_left_padded);
+  ASSERT_EQ(map_stride.stride(1),4);
+  ASSERT_EQ(map_stride.stride(2),16);
+  ASSERT_EQ(map_stride.is_contiguous()?1:0,0);
+
+  layout_left_padded<>::mapping<extents_type> map_left_dynamic(map_stride);
+  ASSERT_EQ(map_left_dynamic.stride(1),4);
+  ASSERT_EQ(map_left_dynamic.stride(2),16);
+
+  layout_left_padded<>::mapping<extents_type> map_left_copy(map_left_padded);
+  ASSERT_EQ(map_left_copy.stride(2),16);
+
+  layout_left_padded<>::mapping<extents_type> map_left_unpadded(map_left);
+  layout_left::mapping<extents_type> map_left_back(map_left_unpadded);
+  ASSERT_EQ(map_left_back.stride(2),12);
+
+  layout_right::mapping<extents_type> map_right(e);
+  layout_right_padded<4>::mapping<extents_type> map_right_padded = map_right;
+  ASSERT_EQ(map_right_padded.stride(1),8);
+  ASSERT_EQ(map_right_padded.stride(0),32);
+  layout_right_padded<>::mapping<extents_type> map_right_unpadded(map_right);
+  layout_right::mapping<extents_type> map_right_back(map_right_unpadded);
+  ASSERT_EQ(map_right_back.stride(0),20);
+
+  layout_right_padded<4>::mapping<extents<5>> map_rank1 = layout_left::mapping<extents<5>>();
+  ASSERT_EQ(map_rank1.required_span_size(),5);
+}
+
 TEST_F(layouts_,operator_right) {
   test_layouts<layout_right,5,dynamic_extent,3,dynamic_extent,1> test(4,2);
 
@@ -173,3 +302,50 @@ TEST_F(layouts_,operator_left) {
 }
 
 
+
+template<class Layout, class Extents>
+void check_operator_matches_strides(const Extents& e) {
+  typename Layout::template mapping<Extents> map(e);
+  for(ptrdiff_t i0 = 0; i0<e.extent(0); i0++)
+  for(ptrdiff_t i1 = 0; i1<e.extent(1); i1++)
+  for(ptrdiff_t i2 = 0; i2<e.extent(2); i2++)
+    ASSERT_EQ(map(i0,i1,i2),i0*map.stride(0)+i1*map.stride(1)+i2*map.stride(2));
+}
+
+TEST_F(layouts_,operator_matches_strides) {
+  check_operator_matches_strides<layout_right>(extents<3,4,5>());
+  check_operator_matches_strides<layout_left >(extents<3,4,5>());
+  check_operator_matches_strides<layout_right>(extents<dynamic_extent,4,5>(3));
+  check_operator_matches_strides<layout_left >(extents<dynamic_extent,4,5>(3));
+  check_operator_matches_strides<layout_right>(extents<3,dynamic_extent,5>(4));
+  check_operator_matches_strides<layout_left >(extents<3,dynamic_extent,5>(4));
+  check_operator_matches_strides<layout_right>(extents<3,4,dynamic_extent>(5));
+  check_operator_matches_strides<layout_left >(extents<3,4,dynamic_extent>(5));
+  check_operator_matches_strides<layout_right>(extents<dynamic_extent,dynamic_extent,dynamic_extent>(3,4,5));
+  check_operator_matches_strides<layout_left >(extents<dynamic_extent,dynamic_extent,dynamic_extent>(3,4,5));
+  check_operator_matches_strides<layout_left_padded<4> >(extents<3,4,5>());
+  check_operator_matches_strides<layout_right_padded<4> >(extents<3,4,5>());
+  check_operator_matches_strides<layout_left_padded<4> >(extents<dynamic_extent,4,5>(3));
+  check_operator_matches_strides<layout_right_padded<4> >(extents<3,4,dynamic_extent>(5));
+  check_operator_matches_strides<layout_left_padded<> >(extents<dynamic_extent,dynamic_extent,dynamic_extent>(3,4,5));
+  check_operator_matches_strides<layout_right_padded<> >(extents<dynamic_extent,dynamic_extent,dynamic_extent>(3,4,5));
+}
+
+TEST_F(layouts_,index_type) {
+  using std::experimental::fundamentals_v3::basic_extents;
+  typedef basic_extents<int32_t,5,dynamic_extent,3,dynamic_extent,1> extents_type;
+  typedef layout_right::mapping<extents_type> mapping_right_type;
+  typedef layout_left::mapping<extents_type> mapping_left_type;
+
+  ASSERT_TRUE((std::is_same<mapping_right_type::index_type,int32_t>::value));
+  ASSERT_TRUE((std::is_same<mapping_left_type::index_type,int32_t>::value));
+  ASSERT_TRUE((std::is_same<decltype(mapping_right_type()(0,0,0,0,0)),int32_t>::value));
+
+  mapping_right_type map_right(extents_type(4,2));
+  mapping_left_type map_left(extents_type(4,2));
+  ASSERT_EQ(map_right(4,1,2,1,0),107);
+  ASSERT_EQ(map_left(4,1,2,1,0),109);
+  ASSERT_EQ(map_right.stride(0),24);
+  ASSERT_EQ(map_left.stride(4),120);
+  ASSERT_EQ(map_right.required_span_size(),120);
+}
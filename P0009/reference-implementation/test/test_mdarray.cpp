@@ -0,0 +1,199 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include<experimental/mdarray>
+#include<cstdio>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class mdarray_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+template<class T>
+struct counting_allocator {
+  using value_type = T;
+
+  size_t* count;
+
+  explicit counting_allocator(size_t* c) : count(c) {}
+  template<class U>
+  counting_allocator(const counting_allocator<U>& other) : count(other.count) {}
+
+  T* allocate(size_t n) { *count += n; return std::allocator<T>().allocate(n); }
+  void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p,n); }
+
+  template<class U>
+  bool operator==(const counting_allocator<U>& other) const { return count == other.count; }
+  template<class U>
+  bool operator!=(const counting_allocator<U>& other) const { return count != other.count; }
+};
+
+TEST_F(mdarray_,static_storage) {
+  typedef mdarray<double,3,4> mdarray_type;
+  ASSERT_TRUE((std::is_same<mdarray_type::container_type,std::array<double,12>>::value));
+  ASSERT_LE(sizeof(mdarray_type),sizeof(std::array<double,12>)+sizeof(double));
+
+  mdarray_type a;
+  for(int i0=0; i0<3; i0++)
+  for(int i1=0; i1<4; i1++)
+    a(i0,i1) = i0*10+i1;
+  ASSERT_EQ(a(2,3),23);
+  ASSERT_EQ(a.data()[4],10);
+
+  typedef basic_mdarray<double,extents<3,4>,layout_left> mdarray_left_type;
+  ASSERT_TRUE((std::is_same<mdarray_left_type::container_type,std::array<double,12>>::value));
+
+  typedef basic_mdarray<double,extents<3,4>,layout_left_padded<4>> mdarray_padded_type;
+  ASSERT_TRUE((std::is_same<mdarray_padded_type::container_type,std::vector<double>>::value));
+  mdarray_padded_type p;
+  ASSERT_EQ(p.container().size(),15u);
+}
+
+TEST_F(mdarray_,dynamic_storage) {
+  typedef mdarray<int,dynamic_extent,4,dynamic_extent> mdarray_type;
+  ASSERT_TRUE((std::is_same<mdarray_type::container_type,std::vector<int>>::value));
+
+  mdarray_type a(3,5);
+  ASSERT_EQ(a.rank(),3);
+  ASSERT_EQ(a.rank_dynamic(),2);
+  ASSERT_EQ(a.extent(0),3);
+  ASSERT_EQ(a.extent(2),5);
+  ASSERT_EQ(a.container().size(),60u);
+  ASSERT_EQ(a.stride(0),20);
+
+  for(int i0=0; i0<3; i0++)
+  for(int i1=0; i1<4; i1++)
+  for(int i2=0; i2<5; i2++)
+    a(i0,i1,i2) = i0*100+i1*10+i2;
+
+  // copies are deep
+  mdarray_type b(a);
+  b(1,2,3) = -1;
+  ASSERT_EQ(a(1,2,3),123);
+  ASSERT_NE(a.data(),b.data());
+
+  const mdarray_type& c = a;
+  ASSERT_TRUE((std::is_same<decltype(c(1,2,3)),const int&>::value));
+  ASSERT_EQ(c(2,3,4),234);
+
+  std::vector<int> v(60,7);
+  const int* v_data = v.data();
+  mdarray_type d(std::move(v),mdarray_type::mapping_type(extents<dynamic_extent,4,dynamic_extent>(3,5)));
+  ASSERT_EQ(d.data(),v_data);
+  ASSERT_EQ(d(2,3,4),7);
+}
+
+TEST_F(mdarray_,to_mdspan) {
+  typedef mdarray<int,dynamic_extent,4> mdarray_type;
+  mdarray_type a(3);
+  for(int i0=0; i0<3; i0++)
+  for(int i1=0; i1<4; i1++)
+    a(i0,i1) = i0*10+i1;
+
+  auto view = a.to_mdspan();
+  ASSERT_TRUE((std::is_same<decltype(view),mdspan<int,dynamic_extent,4>>::value));
+  ASSERT_EQ(view.data(),a.data());
+  view(1,2) = 42;
+  ASSERT_EQ(a(1,2),42);
+
+  const mdarray_type& c = a;
+  auto const_view = c.to_mdspan();
+  ASSERT_TRUE((std::is_same<decltype(const_view)::element_type,const int>::value));
+  ASSERT_EQ(const_view(2,3),23);
+
+  mdspan<int,dynamic_extent,4> converted = a;
+  ASSERT_EQ(&converted(2,1),&a(2,1));
+
+  auto sub = subspan(a.to_mdspan(),1,all);
+  ASSERT_EQ(sub(3),13);
+}
+
+TEST_F(mdarray_,allocator) {
+  size_t count = 0;
+  typedef counting_allocator<float> allocator_type;
+  typedef basic_mdarray<float,extents<dynamic_extent,dynamic_extent>,layout_left,
+                        vector_container_policy<float,allocator_type>> mdarray_type;
+
+  mdarray_type a(extents<dynamic_extent,dynamic_extent>(3,5),allocator_type(&count));
+  ASSERT_EQ(count,15u);
+  ASSERT_EQ(a.container_policy().get_allocator().count,&count);
+  a(2,4) = 1.5f;
+  ASSERT_EQ(a.data()[14],1.5f);
+
+  mdarray_type b(mdarray_type::mapping_type(extents<dynamic_extent,dynamic_extent>(2,2)),allocator_type(&count));
+  ASSERT_EQ(count,19u);
+}
+
+TEST_F(mdarray_,layout_stride_storage) {
+  typedef basic_mdarray<double,extents<3,4>,layout_stride> mdarray_type;
+  ASSERT_TRUE((std::is_same<mdarray_type::container_type,std::vector<double>>::value));
+
+  mdarray_type::mapping_type map(extents<3,4>(),std::array<ptrdiff_t,2>{{4,1}});
+  ASSERT_EQ(map.required_span_size(),12);
+  mdarray_type a(map);
+  ASSERT_EQ(a.container().size(),12u);
+
+  for(int i0=0; i0<3; i0++)
+  for(int i1=0; i1<4; i1++)
+    a(i0,i1) = i0*10+i1;
+  // the last element is the last one in the container
+  ASSERT_EQ(a(2,3),23);
+  ASSERT_EQ(a.data()[11],23);
+
+  // gaps between the rows
+  mdarray_type g(mdarray_type::mapping_type(extents<3,4>(),std::array<ptrdiff_t,2>{{6,1}}));
+  ASSERT_EQ(g.container().size(),16u);
+  g(2,3) = 1.5;
+  ASSERT_EQ(g.data()[15],1.5);
+
+  typedef layout_stride::mapping<extents<dynamic_extent,4>> empty_mapping_type;
+  empty_mapping_type empty(extents<dynamic_extent,4>(0),std::array<ptrdiff_t,2>{{4,1}});
+  ASSERT_EQ(empty.required_span_size(),0);
+}
@@ -218,3 +218,52 @@ TEST_F(mdspan_,operator_left) {
   test.check_operator();
 }
 
+
+TEST_F(mdspan_,trivially_copyable) {
+  typedef basic_mdspan<int,extents<5,dynamic_extent,3,dynamic_extent,1>,
+                 layout_right,accessor_basic<int> > mdspan_right_type;
+  typedef basic_mdspan<int,extents<5,dynamic_extent,3,dynamic_extent,1>,
+                 layout_left,accessor_basic<int> > mdspan_left_type;
+  typedef basic_mdspan<int,extents<5,4,3>,
+                 layout_right,accessor_basic<int> > mdspan_static_type;
+
+  ASSERT_TRUE((std::is_trivially_copyable<mdspan_right_type>::value));
+  ASSERT_TRUE((std::is_trivially_copyable<mdspan_left_type>::value));
+  ASSERT_TRUE((std::is_trivially_copyable<mdspan_static_type>::value));
+}
+
+TEST_F(mdspan_,aligned_accessor) {
+  typedef aligned_accessor<float,32> accessor_type;
+  typedef basic_mdspan<float,extents<dynamic_extent,8>,layout_right,accessor_type> mdspan_aligned_type;
+  typedef basic_mdspan<float,extents<dynamic_extent,8>,layout_right,accessor_basic<float>> mdspan_type;
+
+  ASSERT_EQ(accessor_type::byte_alignment,32u);
+  ASSERT_TRUE((std::is_trivially_copyable<accessor_type>::value));
+  ASSERT_TRUE((std::is_same<accessor_type::offset_policy,accessor_basic<float>>::value));
+  ASSERT_TRUE((std::is_convertible<accessor_type,accessor_basic<float>>::value));
+  ASSERT_TRUE((std::is_convertible<aligned_accessor<float,64>,accessor_type>::value));
+  ASSERT_FALSE((std::is_convertible<aligned_accessor<float,16>,accessor_type>::value));
+  ASSERT_FALSE((std::is_convertible<accessor_basic<float>,accessor_type>::value));
+  ASSERT_FALSE((std::is_convertible<mdspan_type,mdspan_aligned_type>::value));
+  ASSERT_TRUE((std::is_convertible<mdspan_aligned_type,mdspan_type>::value));
+
+  alignas(32) float data[4*8];
+  for(int i=0; i<4*8; i++) data[i] = float(i);
+  ASSERT_TRUE(accessor_type::is_sufficiently_aligned(data));
+  ASSERT_FALSE(accessor_type::is_sufficiently_aligned(data+1));
+
+  mdspan_type a(data,4);
+  mdspan_aligned_type b(a);
+  ASSERT_EQ(b.data(),data);
+  ASSERT_EQ(b(2,3),19.f);
+  b(3,7) = -1.f;
+  ASSERT_EQ(a(3,7),-1.f);
+
+  mdspan_type c = b;
+  ASSERT_EQ(c(1,1),9.f);
+
+  // offsets into the data are no longer aligned
+  auto sub = subspan(b,1,std::pair<int,int>(1,4));
+  ASSERT_TRUE((std::is_same<decltype(sub)::accessor_type,accessor_basic<float>>::value));
+  ASSERT_EQ(sub(0),9.f);
+}
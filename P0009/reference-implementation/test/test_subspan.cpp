@@ -230,3 +230,256 @@ TEST_F(subspan_,basic_mdspan_layout_left) {
 
 //TEST_F(subspan_,reduce_to_rank_0) {
 //}
+
+TEST_F(subspan_,index_type) {
+  typedef basic_mdspan<int,basic_extents<uint32_t,5,dynamic_extent,3>,layout_right,accessor_basic<int>> mdspan_type;
+  int data[5*4*3];
+  for(int i=0; i<5*4*3; i++) data[i] = i;
+  mdspan_type a(data,4);
+
+  auto sub = subspan(a,1,std::pair<int,int>(1,3),all);
+  ASSERT_TRUE((std::is_same<decltype(sub)::index_type,uint32_t>::value));
+  ASSERT_EQ(sub.extent(0),2u);
+  ASSERT_EQ(sub.extent(1),3u);
+  ASSERT_EQ(sub.stride(0),3u);
+  ASSERT_EQ(sub.stride(1),1u);
+  ASSERT_EQ(sub(1,2),a(1,2,2));
+}
+
+TEST_F(subspan_,layout_left_padded) {
+  typedef extents<3,dynamic_extent,5,6> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_left_padded<4>,accessor_basic<int>> mdspan_type;
+  layout_left_padded<4>::mapping<extents_type> map(extents_type(7));
+  int* ptr = new int[map.required_span_size()];
+  mdspan_type a(ptr,map);
+
+  // leading range and trailing full extents stay padded
+  auto sub = subspan(a,std::pair<int,int>(1,3),all,all,2);
+  ASSERT_TRUE((std::is_same<decltype(sub)::layout_type,layout_left_padded<4>>::value));
+  ASSERT_EQ(sub.stride(1),4);
+  ASSERT_EQ(sub.stride(2),28);
+  ASSERT_EQ(&sub(1,2,3),&a(2,2,3,2));
+
+  // skipping rank 1 pads by stride(2) of the source
+  auto sub_skip = subspan(a,all,1,all,std::pair<int,int>(2,4));
+  ASSERT_TRUE((std::is_same<decltype(sub_skip)::layout_type,layout_left_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_skip.stride(1),a.stride(2));
+  ASSERT_EQ(sub_skip.stride(2),a.stride(3));
+  ASSERT_EQ(&sub_skip(2,4,1),&a(2,1,4,3));
+
+  auto sub_static = subspan(a,all,all,1,1);
+  ASSERT_TRUE((std::is_same<decltype(sub_static)::layout_type,layout_left_padded<4>>::value));
+
+  auto sub_column = subspan(a,all,1,2,3);
+  ASSERT_TRUE((std::is_same<decltype(sub_column)::layout_type,layout_left>::value));
+  ASSERT_EQ(&sub_column(2),&a(2,1,2,3));
+
+  auto sub_strided = subspan(a,1,all,all,1);
+  ASSERT_TRUE((std::is_same<decltype(sub_strided)::layout_type,layout_stride>::value));
+  auto sub_gap = subspan(a,all,all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_gap)::layout_type,layout_stride>::value));
+  ASSERT_EQ(&sub_gap(2,4,5),&a(2,4,1,5));
+  delete [] ptr;
+}
+
+TEST_F(subspan_,layout_right_padded) {
+  typedef extents<6,5,dynamic_extent,3> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_right_padded<4>,accessor_basic<int>> mdspan_type;
+  layout_right_padded<4>::mapping<extents_type> map(extents_type(7));
+  int* ptr = new int[map.required_span_size()];
+  mdspan_type a(ptr,map);
+
+  auto sub = subspan(a,2,all,all,std::pair<int,int>(1,3));
+  ASSERT_TRUE((std::is_same<decltype(sub)::layout_type,layout_right_padded<4>>::value));
+  ASSERT_EQ(sub.stride(1),4);
+  ASSERT_EQ(sub.stride(0),28);
+  ASSERT_EQ(&sub(3,2,1),&a(2,3,2,2));
+
+  auto sub_skip = subspan(a,std::pair<int,int>(2,4),all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_skip)::layout_type,layout_right_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_skip.stride(1),a.stride(1));
+  ASSERT_EQ(sub_skip.stride(0),a.stride(0));
+  ASSERT_EQ(&sub_skip(1,4,2),&a(3,4,1,2));
+
+  auto sub_row = subspan(a,1,2,3,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_row)::layout_type,layout_right>::value));
+
+  auto sub_strided = subspan(a,1,all,all,1);
+  ASSERT_TRUE((std::is_same<decltype(sub_strided)::layout_type,layout_stride>::value));
+  delete [] ptr;
+}
+
+TEST_F(subspan_,layout_left_preserved) {
+  typedef extents<3,dynamic_extent,5,6> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_left,accessor_basic<int>> mdspan_type;
+  layout_left::mapping<extents_type> map(extents_type(7));
+  int* ptr = new int[map.required_span_size()];
+  mdspan_type a(ptr,extents_type(7));
+
+  // leading full extents and a trailing range stay contiguous
+  auto sub = subspan(a,all,all,std::pair<int,int>(1,3),2);
+  ASSERT_TRUE((std::is_same<decltype(sub)::layout_type,layout_left>::value));
+  ASSERT_EQ(sub.extent(2),2);
+  ASSERT_EQ(sub.stride(2),a.stride(2));
+  ASSERT_EQ(&sub(2,6,1),&a(2,6,2,2));
+
+  auto sub_column = subspan(a,std::pair<int,int>(1,3),4,1,2);
+  ASSERT_TRUE((std::is_same<decltype(sub_column)::layout_type,layout_left>::value));
+  ASSERT_EQ(&sub_column(1),&a(2,4,1,2));
+
+  // slicing the leading extent pads by the source stride
+  auto sub_block = subspan(a,std::pair<int,int>(1,3),all,1,2);
+  ASSERT_TRUE((std::is_same<decltype(sub_block)::layout_type,layout_left_padded<3>>::value));
+  ASSERT_EQ(sub_block.stride(1),3);
+  ASSERT_EQ(&sub_block(1,6),&a(2,6,1,2));
+
+  auto sub_skip = subspan(a,all,1,all,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_skip)::layout_type,layout_left_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_skip.stride(1),a.stride(2));
+  ASSERT_EQ(sub_skip.stride(2),a.stride(3));
+  ASSERT_EQ(&sub_skip(2,4,5),&a(2,1,4,5));
+
+  auto sub_strided = subspan(a,1,all,all,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_strided)::layout_type,layout_stride>::value));
+  delete [] ptr;
+}
+
+TEST_F(subspan_,layout_right_preserved) {
+  typedef extents<6,5,dynamic_extent,3> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_right,accessor_basic<int>> mdspan_type;
+  layout_right::mapping<extents_type> map(extents_type(7));
+  int* ptr = new int[map.required_span_size()];
+  mdspan_type a(ptr,extents_type(7));
+
+  auto sub = subspan(a,2,std::pair<int,int>(1,3),all,all);
+  ASSERT_TRUE((std::is_same<decltype(sub)::layout_type,layout_right>::value));
+  ASSERT_EQ(sub.stride(0),a.stride(1));
+  ASSERT_EQ(&sub(1,6,2),&a(2,2,6,2));
+
+  auto sub_row = subspan(a,2,1,4,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_row)::layout_type,layout_right>::value));
+  ASSERT_EQ(&sub_row(1),&a(2,1,4,1));
+
+  auto sub_block = subspan(a,2,1,all,std::pair<int,int>(1,3));
+  ASSERT_TRUE((std::is_same<decltype(sub_block)::layout_type,layout_right_padded<3>>::value));
+  ASSERT_EQ(sub_block.stride(0),3);
+  ASSERT_EQ(&sub_block(6,1),&a(2,1,6,2));
+
+  auto sub_skip = subspan(a,all,all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_skip)::layout_type,layout_right_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_skip.stride(0),a.stride(0));
+  ASSERT_EQ(sub_skip.stride(1),a.stride(1));
+  ASSERT_EQ(&sub_skip(5,4,2),&a(5,4,1,2));
+
+  auto sub_strided = subspan(a,all,all,all,1);
+  ASSERT_TRUE((std::is_same<decltype(sub_strided)::layout_type,layout_stride>::value));
+  delete [] ptr;
+}
+
+// A static extent of 0 makes the static padding stride of the subspan 0,
+// which must give a dynamically padded layout rather than a padding of 0
+TEST_F(subspan_,zero_extent_padding) {
+  int* ptr = nullptr;
+
+  basic_mdspan<int,extents<0,3,4>,layout_left,accessor_basic<int>> left(ptr);
+  auto sub_left = subspan(left,all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_left)::layout_type,layout_left_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_left.extent(0),0);
+  ASSERT_EQ(sub_left.extent(1),4);
+  ASSERT_EQ(sub_left.mapping().required_span_size(),0);
+
+  basic_mdspan<int,extents<4,3,0>,layout_right,accessor_basic<int>> right(ptr);
+  auto sub_right = subspan(right,all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_right)::layout_type,layout_right_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_right.extent(0),4);
+  ASSERT_EQ(sub_right.extent(1),0);
+  ASSERT_EQ(sub_right.mapping().required_span_size(),0);
+
+  basic_mdspan<int,extents<0,3,4>,layout_left_padded<4>,accessor_basic<int>> left_padded(ptr);
+  auto sub_left_padded = subspan(left_padded,all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_left_padded)::layout_type,layout_left_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_left_padded.extent(1),4);
+  auto sub_left_block = subspan(left_padded,std::pair<int,int>(0,0),all,1);
+  ASSERT_TRUE((std::is_same<decltype(sub_left_block)::layout_type,layout_left_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_left_block.extent(1),3);
+
+  basic_mdspan<int,extents<4,3,0>,layout_right_padded<4>,accessor_basic<int>> right_padded(ptr);
+  auto sub_right_padded = subspan(right_padded,all,1,all);
+  ASSERT_TRUE((std::is_same<decltype(sub_right_padded)::layout_type,layout_right_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_right_padded.extent(0),4);
+  auto sub_right_block = subspan(right_padded,1,all,std::pair<int,int>(0,0));
+  ASSERT_TRUE((std::is_same<decltype(sub_right_block)::layout_type,layout_right_padded<dynamic_extent>>::value));
+  ASSERT_EQ(sub_right_block.extent(0),3);
+}
+
+TEST_F(subspan_,strided_slice) {
+  typedef extents<dynamic_extent,10> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_right,accessor_basic<int>> mdspan_type;
+  int data[8*10];
+  for(int i=0; i<8*10; i++) data[i] = i;
+  mdspan_type a(data,8);
+
+  // every other row and every third column starting at (1,1)
+  auto sub = subspan(a,strided_slice{1,7,2},strided_slice{1,9,3});
+  ASSERT_TRUE((std::is_same<decltype(sub)::layout_type,layout_stride>::value));
+  ASSERT_EQ(sub.rank_dynamic(),2);
+  ASSERT_EQ(sub.extent(0),4);
+  ASSERT_EQ(sub.extent(1),3);
+  ASSERT_EQ(sub.stride(0),20);
+  ASSERT_EQ(sub.stride(1),3);
+  for(int i0=0; i0<sub.extent(0); i0++)
+  for(int i1=0; i1<sub.extent(1); i1++)
+    ASSERT_EQ(sub(i0,i1),a(1+2*i0,1+3*i1));
+
+  // static extent and stride give a static sub extent
+  typedef std::integral_constant<int,2> two;
+  typedef std::integral_constant<int,5> five;
+  auto sub_static = subspan(a,1,strided_slice{0,five(),two()});
+  ASSERT_EQ(sub_static.rank_dynamic(),0);
+  ASSERT_EQ(sub_static.static_extent(0),3);
+  ASSERT_EQ(sub_static.stride(0),2);
+  ASSERT_EQ(sub_static(2),a(1,4));
+
+  // a stride larger than the extent selects a single index
+  auto sub_single = subspan(a,strided_slice{3,2,4},all);
+  ASSERT_EQ(sub_single.extent(0),1);
+  ASSERT_EQ(sub_single.stride(0),a.stride(0));
+  ASSERT_EQ(sub_single(0,5),a(3,5));
+
+  auto sub_empty = subspan(a,strided_slice{3,0,4},all);
+  ASSERT_EQ(sub_empty.extent(0),0);
+}
+
+TEST_F(subspan_,static_slices) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_right,accessor_basic<int>> mdspan_type;
+  int data[8*10];
+  for(int i=0; i<8*10; i++) data[i] = i;
+  mdspan_type a(data,8,10);
+
+  typedef std::integral_constant<int,2> c2;
+  typedef std::integral_constant<int,4> c4;
+  typedef std::integral_constant<int,6> c6;
+
+  // a 4x4 tile has fully static extents
+  auto tile = subspan(a,std::pair<c2,c6>(),std::pair<c4,std::integral_constant<int,8>>());
+  ASSERT_EQ(tile.rank_dynamic(),0);
+  ASSERT_EQ(tile.static_extent(0),4);
+  ASSERT_EQ(tile.static_extent(1),4);
+  ASSERT_TRUE((std::is_same<decltype(tile)::layout_type,layout_right_padded<dynamic_extent>>::value));
+  ASSERT_EQ(tile.stride(0),10);
+  for(int i0=0; i0<4; i0++)
+  for(int i1=0; i1<4; i1++)
+    ASSERT_EQ(tile(i0,i1),a(2+i0,4+i1));
+
+  // integral_constant indices and mixed pairs
+  auto row = subspan(a,c2(),std::pair<c2,c6>());
+  ASSERT_EQ(row.static_extent(0),4);
+  ASSERT_TRUE((std::is_same<decltype(row)::layout_type,layout_right>::value));
+  ASSERT_EQ(row(3),a(2,5));
+
+  auto mixed = subspan(a,std::pair<int,c4>(1,c4()),all);
+  ASSERT_EQ(mixed.static_extent(0),dynamic_extent);
+  ASSERT_EQ(mixed.extent(0),3);
+  ASSERT_EQ(mixed(2,7),a(3,7));
+}
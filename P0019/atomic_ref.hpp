@@ -10,9 +10,22 @@
 #define ATOMIC_REF_HPP
 
 #include <atomic>
+#include <chrono>
+#include <climits>
 #include <type_traits>
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#if defined( __linux__ )
+  #include <ctime>
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
 
 #if defined( _MSC_VER ) //msvc
   #error "Error: MSVC not currently supported"
@@ -22,6 +35,22 @@
   #define ATOMIC_REF_FORCEINLINE inline __attribute__((always_inline))
 #endif
 
+// 16 byte types use lock cmpxchg16b on x86-64.  It is always available
+// when compiling with -mcx16, otherwise the cpu is checked at run time and
+// libatomic is used if it lacks the instruction.
+#if defined( __x86_64__ )
+  #include <cpuid.h>
+  #define ATOMIC_REF_CMPXCHG16B 1
+#else
+  #define ATOMIC_REF_CMPXCHG16B 0
+#endif
+
+#if ATOMIC_REF_CMPXCHG16B && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16 )
+  #define ATOMIC_REF_ALWAYS_CMPXCHG16B 1
+#else
+  #define ATOMIC_REF_ALWAYS_CMPXCHG16B 0
+#endif
+
 static_assert(  (__ATOMIC_RELAXED == std::memory_order_relaxed )
              && (__ATOMIC_CONSUME == std::memory_order_consume )
              && (__ATOMIC_ACQUIRE == std::memory_order_acquire )
@@ -35,6 +64,88 @@ namespace Foo {
 
 namespace Impl {
 
+ATOMIC_REF_FORCEINLINE
+void atomic_pause() noexcept
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+  __builtin_ia32_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+  __asm__ __volatile__( "yield" );
+#endif
+}
+
+} // namespace Impl
+
+//------------------------------------------------------------------------------
+// backoff policies
+//
+// The BackoffPolicy of atomic_ref<T, BackoffPolicy> is default constructed
+// at the start of every compare-exchange loop (fetch_update, fetch_min,
+// fetch_max and the floating-point fetch_add/fetch_sub fallback) and
+// called with the address of the object after every failed attempt.
+//------------------------------------------------------------------------------
+
+// retry immediately
+struct backoff_none
+{
+  ATOMIC_REF_FORCEINLINE
+  void operator()( const void * ) noexcept {}
+};
+
+// one pause (x86) or yield (ARM) instruction
+struct backoff_pause
+{
+  ATOMIC_REF_FORCEINLINE
+  void operator()( const void * ) noexcept
+  {
+    Impl::atomic_pause();
+  }
+};
+
+// 1, 2, 4, ... up to 64 pause instructions
+struct backoff_exponential
+{
+  unsigned count = 1;
+
+  ATOMIC_REF_FORCEINLINE
+  void operator()( const void * ) noexcept
+  {
+    for (unsigned i = 0; i < count; ++i) {
+      Impl::atomic_pause();
+    }
+    if ( count < 64 ) {
+      count *= 2;
+    }
+  }
+};
+
+// exponential pauses, then a fixed sleep of sleep_ns per failed attempt.
+// Nothing wakes the sleeping thread early (a successful update does not
+// notify), so this only pays off when the contention outlasts the sleep,
+// e.g., with many more threads than cores; otherwise prefer
+// backoff_exponential.
+struct backoff_sleep
+{
+  static constexpr unsigned spin_limit = 64;
+  static constexpr long     sleep_ns   = 50000;
+
+  unsigned count = 1;
+
+  void operator()( const void * ) noexcept
+  {
+    if ( count <= spin_limit ) {
+      for (unsigned i = 0; i < count; ++i) {
+        Impl::atomic_pause();
+      }
+      count *= 2;
+      return;
+    }
+    std::this_thread::sleep_for( std::chrono::nanoseconds( sleep_ns ) );
+  }
+};
+
+namespace Impl {
+
 //------------------------------------------------------------------------------
 template <typename T>
 inline constexpr size_t atomic_ref_required_alignment_v = sizeof(T) == sizeof(uint8_t)  ? sizeof(uint8_t)
@@ -73,6 +184,111 @@ using atomic_ref_cast_t = std::conditional_t< sizeof(T) == sizeof(uint8_t),  uin
                         >>>>>
                         ;
 
+//------------------------------------------------------------------------------
+// compare-exchange loop helpers
+//------------------------------------------------------------------------------
+
+// strongest order allowed for the failure of a compare-exchange
+constexpr std::memory_order atomic_failure_order( std::memory_order order ) noexcept
+{
+  return order == std::memory_order_acq_rel ? std::memory_order_acquire
+       : order == std::memory_order_release ? std::memory_order_relaxed
+       : order
+       ;
+}
+
+//------------------------------------------------------------------------------
+// cmpxchg16b
+//
+// Every operation is a lock cmpxchg16b, which is a full barrier, so the
+// memory order is always seq_cst.  Loads write the value back and therefore
+// need writable memory.
+//------------------------------------------------------------------------------
+#if ATOMIC_REF_CMPXCHG16B
+
+inline bool cpu_has_cmpxchg16b() noexcept
+{
+#if ATOMIC_REF_ALWAYS_CMPXCHG16B
+  return true;
+#else
+  static const bool has_cmpxchg16b = []() {
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid( 1, &eax, &ebx, &ecx, &edx ) && ( ecx & bit_CMPXCHG16B ) != 0;
+  }();
+  return has_cmpxchg16b;
+#endif
+}
+
+ATOMIC_REF_FORCEINLINE
+bool cmpxchg16b( void * ptr, __uint128_t & expected, __uint128_t desired ) noexcept
+{
+  typedef __uint128_t __attribute__((__may_alias__)) cast_type;
+
+  uint64_t expected_lo = static_cast<uint64_t>( expected );
+  uint64_t expected_hi = static_cast<uint64_t>( expected >> 64 );
+  bool success;
+
+  __asm__ __volatile__( "lock cmpxchg16b %1"
+                      : "=@ccz"( success )
+                      , "+m"( *static_cast<cast_type*>(ptr) )
+                      , "+a"( expected_lo )
+                      , "+d"( expected_hi )
+                      : "b"( static_cast<uint64_t>( desired ) )
+                      , "c"( static_cast<uint64_t>( desired >> 64 ) )
+                      : "memory"
+                      );
+
+  expected = ( static_cast<__uint128_t>( expected_hi ) << 64 ) | expected_lo;
+  return success;
+}
+
+ATOMIC_REF_FORCEINLINE
+__uint128_t cmpxchg16b_load( void * ptr ) noexcept
+{
+  __uint128_t value = 0;
+  cmpxchg16b( ptr, value, value );
+  return value;
+}
+
+ATOMIC_REF_FORCEINLINE
+__uint128_t cmpxchg16b_exchange( void * ptr, __uint128_t desired ) noexcept
+{
+  __uint128_t expected = 0;
+  while ( ! cmpxchg16b( ptr, expected, desired ) ) {}
+  return expected;
+}
+
+#else
+
+// declared only, calls are discarded by atomic_use_cmpxchg16b_v
+bool cpu_has_cmpxchg16b() noexcept;
+bool cmpxchg16b( void * ptr, __uint128_t & expected, __uint128_t desired ) noexcept;
+__uint128_t cmpxchg16b_load( void * ptr ) noexcept;
+__uint128_t cmpxchg16b_exchange( void * ptr, __uint128_t desired ) noexcept;
+
+#endif
+
+template <typename T>
+inline constexpr bool atomic_use_cmpxchg16b_v = ATOMIC_REF_CMPXCHG16B && sizeof(T) == 16;
+
+template <typename T>
+ATOMIC_REF_FORCEINLINE
+__uint128_t to_bits16( const T & value ) noexcept
+{
+  __uint128_t bits;
+  std::memcpy( &bits, &value, 16 );
+  return bits;
+}
+
+template <typename T>
+ATOMIC_REF_FORCEINLINE
+T from_bits16( const __uint128_t & bits ) noexcept
+{
+  T value;
+  std::memcpy( static_cast<void*>(&value), &bits, 16 );
+  return value;
+}
+
 //------------------------------------------------------------------------------
 // atomic_ref_ops: generic
 //------------------------------------------------------------------------------
@@ -189,7 +405,7 @@ struct atomic_ref_ops< Base, ValueType
   ATOMIC_REF_FORCEINLINE
   difference_type operator&=(difference_type val) const noexcept
   {
-    return __atomic_sub_fetch( static_cast<const Base*>(this)->ptr_, val, std::memory_order_seq_cst );
+    return __atomic_and_fetch( static_cast<const Base*>(this)->ptr_, val, std::memory_order_seq_cst );
   }
 
   ATOMIC_REF_FORCEINLINE
@@ -203,9 +419,87 @@ struct atomic_ref_ops< Base, ValueType
   {
     return __atomic_xor_fetch( static_cast<const Base*>(this)->ptr_, val, std::memory_order_seq_cst );
   }
+  ATOMIC_REF_FORCEINLINE
+  difference_type fetch_min( difference_type val
+                           , std::memory_order order = std::memory_order_seq_cst
+                           ) const noexcept
+  {
+    return static_cast<const Base*>(this)->
+             fetch_update( [val]( difference_type v ) { return val < v ? val : v; }, order );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  difference_type fetch_max( difference_type val
+                           , std::memory_order order = std::memory_order_seq_cst
+                           ) const noexcept
+  {
+    return static_cast<const Base*>(this)->
+             fetch_update( [val]( difference_type v ) { return v < val ? val : v; }, order );
+  }
 };
 
 
+//------------------------------------------------------------------------------
+// floating-point fetch_add / fetch_sub
+//
+// clang accepts floating-point operands to __atomic_fetch_add/sub and lowers
+// them to the native instruction of targets that have one.  Elsewhere the
+// operation is a compare-exchange loop on the bit representation, which
+// compares bits instead of values (so NaNs cannot make it spin) and needs no
+// reload on failure.
+//------------------------------------------------------------------------------
+#ifndef ATOMIC_REF_NATIVE_FLOAT_OPS
+  #if defined( __clang__ ) && ( __clang_major__ >= 12 )
+    #define ATOMIC_REF_NATIVE_FLOAT_OPS 1
+  #else
+    #define ATOMIC_REF_NATIVE_FLOAT_OPS 0
+  #endif
+#endif
+
+template <typename T>
+inline constexpr bool atomic_use_native_float_ops_v =  ATOMIC_REF_NATIVE_FLOAT_OPS
+                                                    && (  std::is_same_v<T, float>
+                                                       || std::is_same_v<T, double>
+                                                       )
+                                                    ;
+
+template <typename BackoffPolicy, typename T, typename BinaryOp>
+ATOMIC_REF_FORCEINLINE
+T atomic_fetch_float_op( T * ptr, T val, BinaryOp op, std::memory_order order ) noexcept
+{
+  static_assert( atomic_use_cast_ops_v<T>
+               , "Error: floating-point atomic_ref requires an integer type of the same size");
+
+  typedef atomic_ref_cast_t<T> __attribute__((__may_alias__)) cast_type;
+
+  cast_type * bits = reinterpret_cast<cast_type*>(ptr);
+  cast_type expected = __atomic_load_n( bits, std::memory_order_relaxed );
+  cast_type desired;
+  T old;
+
+  BackoffPolicy backoff;
+
+  while (true) {
+    std::memcpy( &old, &expected, sizeof(T) );
+    const T result = op( old, val );
+    std::memcpy( &desired, &result, sizeof(T) );
+
+    if ( __atomic_compare_exchange_n( bits
+                                    , &expected
+                                    , desired
+                                    , true
+                                    , order
+                                    , std::memory_order_relaxed
+                                    )
+       ) {
+      return old;
+    }
+
+    backoff( ptr );
+  }
+}
+
+
 //------------------------------------------------------------------------------
 // atomic_ref_ops: floating-point
 //------------------------------------------------------------------------------
@@ -222,22 +516,16 @@ struct atomic_ref_ops< Base, ValueType
                            , std::memory_order order = std::memory_order_seq_cst
                            ) const noexcept
   {
-    difference_type expected = static_cast<const Base*>(this)->load(std::memory_order_relaxed);
-    difference_type desired = expected + val;
-
-    while (! static_cast<const Base*>(this)->
-              compare_exchange_weak( expected
-                                   , desired
-                                   , order
-                                   , std::memory_order_relaxed
-                                   )
-         )
-    {
-      desired = expected + val;
-      if (std::isnan(expected)) break;
+    if constexpr ( atomic_use_native_float_ops_v<ValueType> ) {
+      return __atomic_fetch_add( static_cast<const Base*>(this)->ptr_, val, order );
+    }
+    else {
+      return atomic_fetch_float_op< typename Base::backoff_policy >( static_cast<const Base*>(this)->ptr_
+                                  , val
+                                  , []( ValueType a, ValueType b ) { return a + b; }
+                                  , order
+                                  );
     }
-
-    return expected;
   }
 
   ATOMIC_REF_FORCEINLINE
@@ -245,22 +533,16 @@ struct atomic_ref_ops< Base, ValueType
                            , std::memory_order order = std::memory_order_seq_cst
                            ) const noexcept
   {
-    difference_type expected = static_cast<const Base*>(this)->load(std::memory_order_relaxed);
-    difference_type desired = expected - val;
-
-    while (! static_cast<const Base*>(this)->
-              compare_exchange_weak( expected
-                                   , desired
-                                   , order
-                                   , std::memory_order_relaxed
-                                   )
-         )
-    {
-      desired = expected - val;
-      if (std::isnan(expected)) break;
+    if constexpr ( atomic_use_native_float_ops_v<ValueType> ) {
+      return __atomic_fetch_sub( static_cast<const Base*>(this)->ptr_, val, order );
+    }
+    else {
+      return atomic_fetch_float_op< typename Base::backoff_policy >( static_cast<const Base*>(this)->ptr_
+                                  , val
+                                  , []( ValueType a, ValueType b ) { return a - b; }
+                                  , order
+                                  );
     }
-
-    return expected;
   }
 
   ATOMIC_REF_FORCEINLINE
@@ -274,6 +556,23 @@ struct atomic_ref_ops< Base, ValueType
   {
     return fetch_sub( val ) - val;
   }
+  ATOMIC_REF_FORCEINLINE
+  difference_type fetch_min( difference_type val
+                           , std::memory_order order = std::memory_order_seq_cst
+                           ) const noexcept
+  {
+    return static_cast<const Base*>(this)->
+             fetch_update( [val]( difference_type v ) { return val < v ? val : v; }, order );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  difference_type fetch_max( difference_type val
+                           , std::memory_order order = std::memory_order_seq_cst
+                           ) const noexcept
+  {
+    return static_cast<const Base*>(this)->
+             fetch_update( [val]( difference_type v ) { return v < val ? val : v; }, order );
+  }
 };
 
 
@@ -383,11 +682,274 @@ struct atomic_ref_ops< Base, ValueType
   }
 };
 
+//------------------------------------------------------------------------------
+// lock_reference / unlock_reference customization points (P1372)
+//
+// Dispatch to obj.lock_reference() if that is well-formed and otherwise to
+// lock_reference(obj) found by argument dependent lookup.  atomic_ref<T>
+// uses them for every operation when T is customized and not always
+// lock-free, instead of the lock table of libatomic.
+//------------------------------------------------------------------------------
+namespace lock_reference_cpo {
+
+template <typename T> void lock_reference( T & ) = delete;
+template <typename T> void unlock_reference( T & ) = delete;
+
+template <typename T, typename Enable = void>
+struct has_member : std::false_type {};
+
+template <typename T>
+struct has_member< T, std::void_t< decltype( std::declval<T&>().lock_reference() )
+                                 , decltype( std::declval<T&>().unlock_reference() )
+                                 >
+                 > : std::true_type {};
+
+template <typename T, typename Enable = void>
+struct has_adl : std::false_type {};
+
+template <typename T>
+struct has_adl< T, std::void_t< decltype( lock_reference( std::declval<T&>() ) )
+                              , decltype( unlock_reference( std::declval<T&>() ) )
+                              >
+              > : std::true_type {};
+
+struct lock_fn
+{
+  template <typename T>
+  ATOMIC_REF_FORCEINLINE
+  auto operator()( T & obj ) const noexcept
+    -> std::enable_if_t< has_member<T>::value || has_adl<T>::value >
+  {
+    if constexpr ( has_member<T>::value ) {
+      obj.lock_reference();
+    }
+    else {
+      lock_reference( obj );
+    }
+  }
+};
+
+struct unlock_fn
+{
+  template <typename T>
+  ATOMIC_REF_FORCEINLINE
+  auto operator()( T & obj ) const noexcept
+    -> std::enable_if_t< has_member<T>::value || has_adl<T>::value >
+  {
+    if constexpr ( has_member<T>::value ) {
+      obj.unlock_reference();
+    }
+    else {
+      unlock_reference( obj );
+    }
+  }
+};
+
+} // namespace lock_reference_cpo
+
+template <typename T>
+inline constexpr bool atomic_always_lock_free_v =  ( sizeof(T) == 16 && ATOMIC_REF_ALWAYS_CMPXCHG16B )
+                                                || __atomic_always_lock_free( sizeof(T) <= atomic_ref_required_alignment_v<T>
+                                                                              ? atomic_ref_required_alignment_v<T>
+                                                                              : sizeof(T)
+                                                                            , nullptr
+                                                                            )
+                                                ;
+
+template <typename T>
+inline constexpr bool atomic_use_lock_reference_v =  !atomic_always_lock_free_v<T>
+                                                  && (  lock_reference_cpo::has_member<T>::value
+                                                     || lock_reference_cpo::has_adl<T>::value
+                                                     )
+                                                  ;
+
+//------------------------------------------------------------------------------
+// wait / notify
+//
+// Waiters register in a table of buckets hashed by address, so that notify
+// can skip the system call when nobody waits.  32-bit objects are waited
+// on directly with a futex.  Other sizes wait on the epoch of their bucket,
+// which notify increments.  Without futexes waiting degrades to yielding.
+//------------------------------------------------------------------------------
+struct alignas(64) waiter_bucket
+{
+  std::atomic<uint32_t> epoch{0};
+  std::atomic<uint32_t> waiters{0};
+};
+
+inline waiter_bucket & waiter_bucket_for( const void * address ) noexcept
+{
+  static waiter_bucket buckets[256];
+  const uintptr_t a = reinterpret_cast<uintptr_t>(address);
+  return buckets[ ( (a >> 4) ^ (a >> 12) ) % 256 ];
+}
+
+// blocks while the 32-bit word at address equals old, or spuriously
+inline void futex_wait( const void * address, uint32_t old ) noexcept
+{
+#if defined( __linux__ )
+  syscall( SYS_futex, address, FUTEX_WAIT_PRIVATE, old, nullptr, nullptr, 0 );
+#else
+  (void)address;
+  (void)old;
+  std::this_thread::yield();
+#endif
+}
+
+inline void futex_wake( const void * address, int count ) noexcept
+{
+#if defined( __linux__ )
+  syscall( SYS_futex, address, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0 );
+#else
+  (void)address;
+  (void)count;
+#endif
+}
+
+template <typename T>
+inline constexpr bool atomic_wait_on_object_v = sizeof(T) == sizeof(uint32_t)
+                                              && atomic_ref_required_alignment_v<T> == alignof(uint32_t)
+                                              ;
+
+// Load returns the current value with the order of the wait
+template <typename T, typename Load>
+void atomic_wait( const T * ptr, const T & old, Load load ) noexcept
+{
+  waiter_bucket & bucket = waiter_bucket_for( ptr );
+
+  while (true) {
+    bucket.waiters.fetch_add( 1, std::memory_order_seq_cst );
+    // Store-load pairing with the fence in atomic_notify: either notify
+    // sees this waiter, or the load below sees the notifier's store.  The
+    // fence is needed since load() may be relaxed (atomic_ref_relaxed).
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    const uint32_t epoch = bucket.epoch.load( std::memory_order_seq_cst );
+    const T current = load();
+
+    if ( std::memcmp( &current, &old, sizeof(T) ) != 0 ) {
+      bucket.waiters.fetch_sub( 1, std::memory_order_relaxed );
+      return;
+    }
+
+    if constexpr ( atomic_wait_on_object_v<T> ) {
+      uint32_t old_bits;
+      std::memcpy( &old_bits, &old, sizeof(uint32_t) );
+      futex_wait( ptr, old_bits );
+    }
+    else {
+      futex_wait( &bucket.epoch, epoch );
+    }
+
+    bucket.waiters.fetch_sub( 1, std::memory_order_relaxed );
+  }
+}
+
+template <typename T>
+void atomic_notify( const T * ptr, bool all ) noexcept
+{
+  waiter_bucket & bucket = waiter_bucket_for( ptr );
+
+  // orders the preceding store before reading the waiter count, pairs
+  // with the fence after the increment in atomic_wait
+  std::atomic_thread_fence( std::memory_order_seq_cst );
+  if ( bucket.waiters.load( std::memory_order_relaxed ) == 0 ) {
+    return;
+  }
+
+  if constexpr ( atomic_wait_on_object_v<T> ) {
+    futex_wake( ptr, all ? INT_MAX : 1 );
+  }
+  else {
+    // other objects may share the bucket, so always wake all of them
+    bucket.epoch.fetch_add( 1, std::memory_order_seq_cst );
+    futex_wake( &bucket.epoch, INT_MAX );
+  }
+}
+
 } // namespace Impl
 
-template < class T >
+inline constexpr Impl::lock_reference_cpo::lock_fn   lock_reference{};
+inline constexpr Impl::lock_reference_cpo::unlock_fn unlock_reference{};
+
+//------------------------------------------------------------------------------
+// lock_pool: cache line padded spinlocks selected by hashing the address
+//
+// A ready-made implementation of the customization points, e.g.
+//
+//   struct bbox { float lo[4], hi[4]; };
+//   void lock_reference( bbox & b )   { Foo::lock_pool::global().lock( &b ); }
+//   void unlock_reference( bbox & b ) { Foo::lock_pool::global().unlock( &b ); }
+//------------------------------------------------------------------------------
+class lock_pool
+{
+  struct alignas(64) padded_lock
+  {
+    std::atomic<bool> locked{false};
+  };
+
+  std::unique_ptr<padded_lock[]> locks_;
+  size_t mask_;
+
+  ATOMIC_REF_FORCEINLINE
+  padded_lock & lock_for( const void * address ) const noexcept
+  {
+    // Fibonacci hash so that addresses with a common large stride (chunks
+    // of a bulk update, rows of a matrix) spread over the whole pool
+    const uint64_t a = reinterpret_cast<uintptr_t>(address) >> 4;
+    return locks_[ ( ( a * 0x9E3779B97F4A7C15ull ) >> 32 ) & mask_ ];
+  }
+
+  static size_t default_size() noexcept
+  {
+    size_t n = 1;
+    while ( n < 4u * std::thread::hardware_concurrency() ) n *= 2;
+    return n;
+  }
+
+public:
+
+  // num_locks is rounded up to a power of two, the default is at least four
+  // locks per hardware thread
+  explicit lock_pool( size_t num_locks = default_size() )
+  {
+    size_t n = 1;
+    while ( n < num_locks ) n *= 2;
+    locks_.reset( new padded_lock[n] );
+    mask_ = n - 1;
+  }
+
+  lock_pool( const lock_pool & ) = delete;
+  lock_pool & operator=( const lock_pool & ) = delete;
+
+  size_t size() const noexcept { return mask_ + 1; }
+
+  ATOMIC_REF_FORCEINLINE
+  void lock( const void * address ) const noexcept
+  {
+    std::atomic<bool> & locked = lock_for(address).locked;
+    while ( locked.exchange( true, std::memory_order_acquire ) ) {
+      while ( locked.load( std::memory_order_relaxed ) ) {
+        Impl::atomic_pause();
+      }
+    }
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void unlock( const void * address ) const noexcept
+  {
+    lock_for(address).locked.store( false, std::memory_order_release );
+  }
+
+  static lock_pool & global()
+  {
+    static lock_pool pool;
+    return pool;
+  }
+};
+
+template < class T, class BackoffPolicy = backoff_exponential >
 struct atomic_ref
-  : public Impl::atomic_ref_ops< atomic_ref<T>, T >
+  : public Impl::atomic_ref_ops< atomic_ref<T, BackoffPolicy>, T >
 {
   static_assert( std::is_trivially_copyable_v<T>
                , "Error: atomic_ref<T> requires T to be trivially copyable");
@@ -395,18 +957,42 @@ struct atomic_ref
 private:
   T* ptr_;
 
-  friend struct Impl::atomic_ref_ops< atomic_ref<T>, T>;
+  friend struct Impl::atomic_ref_ops< atomic_ref<T, BackoffPolicy>, T>;
+
+  // compares the object representations like __atomic_compare_exchange
+  ATOMIC_REF_FORCEINLINE
+  bool locked_compare_exchange( T & expected, const T & desired ) const noexcept
+  {
+    lock_reference( *ptr_ );
+    const bool equal = std::memcmp( ptr_, &expected, sizeof(T) ) == 0;
+    if ( equal ) {
+      std::memcpy( static_cast<void*>(ptr_), &desired, sizeof(T) );
+    }
+    else {
+      std::memcpy( static_cast<void*>(&expected), ptr_, sizeof(T) );
+    }
+    unlock_reference( *ptr_ );
+    return equal;
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  bool cmpxchg16b_compare_exchange( T & expected, const T & desired ) const noexcept
+  {
+    __uint128_t expected_bits = Impl::to_bits16( expected );
+    const bool exchanged = Impl::cmpxchg16b( ptr_, expected_bits, Impl::to_bits16( desired ) );
+    if ( !exchanged ) {
+      expected = Impl::from_bits16<T>( expected_bits );
+    }
+    return exchanged;
+  }
 
 public:
 
   using value_type = T;
+  using backoff_policy = BackoffPolicy;
 
   static constexpr size_t required_alignment  = Impl::atomic_ref_required_alignment_v<T>;
-  static constexpr bool   is_always_lock_free = __atomic_always_lock_free( sizeof(T) <= required_alignment
-                                                                                      ? required_alignment 
-                                                                                      : sizeof(T)
-                                                                         , nullptr
-                                                                         );
+  static constexpr bool   is_always_lock_free = Impl::atomic_always_lock_free_v<T>;
 
   atomic_ref() = delete;
   atomic_ref & operator=( const atomic_ref & ) = delete;
@@ -435,7 +1021,12 @@ public:
   ATOMIC_REF_FORCEINLINE
   bool is_lock_free() const noexcept
   {
-    return __atomic_is_lock_free( sizeof(value_type), ptr_ );
+    if constexpr ( Impl::atomic_use_cmpxchg16b_v<T> && !Impl::atomic_use_lock_reference_v<T> ) {
+      return Impl::cpu_has_cmpxchg16b();
+    }
+    else {
+      return __atomic_is_lock_free( sizeof(value_type), ptr_ );
+    }
   }
 
   ATOMIC_REF_FORCEINLINE
@@ -443,7 +1034,20 @@ public:
             , std::memory_order order = std::memory_order_seq_cst
             ) const noexcept
   {
-    if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
+    if constexpr ( Impl::atomic_use_lock_reference_v<T> ) {
+      lock_reference( *ptr_ );
+      std::memcpy( static_cast<void*>(ptr_), &desired, sizeof(T) );
+      unlock_reference( *ptr_ );
+    }
+    else if constexpr ( Impl::atomic_use_cmpxchg16b_v<T> ) {
+      if ( Impl::cpu_has_cmpxchg16b() ) {
+        Impl::cmpxchg16b_exchange( ptr_, Impl::to_bits16( desired ) );
+      }
+      else {
+        __atomic_store( ptr_, &desired, order );
+      }
+    }
+    else if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
       __atomic_store_n( ptr_, desired, order );
     }
     else if constexpr ( Impl::atomic_use_cast_ops_v<T> ) {
@@ -462,7 +1066,22 @@ public:
   ATOMIC_REF_FORCEINLINE
   value_type load( std::memory_order order = std::memory_order_seq_cst ) const noexcept
   {
-    if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
+    if constexpr ( Impl::atomic_use_lock_reference_v<T> ) {
+      value_type result;
+      lock_reference( *ptr_ );
+      std::memcpy( static_cast<void*>(&result), ptr_, sizeof(T) );
+      unlock_reference( *ptr_ );
+      return result;
+    }
+    else if constexpr ( Impl::atomic_use_cmpxchg16b_v<T> ) {
+      if ( Impl::cpu_has_cmpxchg16b() ) {
+        return Impl::from_bits16<T>( Impl::cmpxchg16b_load( ptr_ ) );
+      }
+      value_type result;
+      __atomic_load( ptr_, &result, order );
+      return result;
+    }
+    else if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
       return __atomic_load_n( ptr_, order );
     }
     else if constexpr ( Impl::atomic_use_cast_ops_v<T> ) {
@@ -471,7 +1090,9 @@ public:
       cast_type tmp = __atomic_load_n( reinterpret_cast<cast_type*>(ptr_)
                                      , order
                                      );
-      return *reinterpret_cast<value_type*>(&tmp);
+      value_type result;
+      std::memcpy( static_cast<void*>(&result), &tmp, sizeof(value_type) );
+      return result;
     }
     else {
       value_type result;
@@ -485,7 +1106,23 @@ public:
                      , std::memory_order order = std::memory_order_seq_cst
                      ) const noexcept
   {
-    if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
+    if constexpr ( Impl::atomic_use_lock_reference_v<T> ) {
+      value_type result;
+      lock_reference( *ptr_ );
+      std::memcpy( static_cast<void*>(&result), ptr_, sizeof(T) );
+      std::memcpy( static_cast<void*>(ptr_), &desired, sizeof(T) );
+      unlock_reference( *ptr_ );
+      return result;
+    }
+    else if constexpr ( Impl::atomic_use_cmpxchg16b_v<T> ) {
+      if ( Impl::cpu_has_cmpxchg16b() ) {
+        return Impl::from_bits16<T>( Impl::cmpxchg16b_exchange( ptr_, Impl::to_bits16( desired ) ) );
+      }
+      value_type result;
+      __atomic_exchange( ptr_, &desired, &result, order );
+      return result;
+    }
+    else if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
       return __atomic_exchange_n( ptr_, desired, order );
     }
     else if constexpr ( Impl::atomic_use_cast_ops_v<T> ) {
@@ -495,7 +1132,9 @@ public:
                                          , *reinterpret_cast<cast_type*>(&desired)
                                          , order
                                          );
-      return *reinterpret_cast<value_type*>(&tmp);
+      value_type result;
+      std::memcpy( static_cast<void*>(&result), &tmp, sizeof(value_type) );
+      return result;
     }
     else {
       value_type result;
@@ -511,7 +1150,16 @@ public:
                             , std::memory_order failure
                             ) const noexcept
   {
-    if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
+    if constexpr ( Impl::atomic_use_lock_reference_v<T> ) {
+      return locked_compare_exchange( expected, desired );
+    }
+    else if constexpr ( Impl::atomic_use_cmpxchg16b_v<T> ) {
+      if ( Impl::cpu_has_cmpxchg16b() ) {
+        return cmpxchg16b_compare_exchange( expected, desired );
+      }
+      return __atomic_compare_exchange( ptr_, &expected, &desired, true, success, failure );
+    }
+    else if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
       return __atomic_compare_exchange_n( ptr_, &expected, desired, true, success, failure );
     }
     else if constexpr ( Impl::atomic_use_cast_ops_v<T> ) {
@@ -537,7 +1185,16 @@ public:
                               , std::memory_order failure
                               ) const noexcept
   {
-    if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
+    if constexpr ( Impl::atomic_use_lock_reference_v<T> ) {
+      return locked_compare_exchange( expected, desired );
+    }
+    else if constexpr ( Impl::atomic_use_cmpxchg16b_v<T> ) {
+      if ( Impl::cpu_has_cmpxchg16b() ) {
+        return cmpxchg16b_compare_exchange( expected, desired );
+      }
+      return __atomic_compare_exchange( ptr_, &expected, &desired, false, success, failure );
+    }
+    else if constexpr ( Impl::atomic_use_native_ops_v<T> ) {
       return __atomic_compare_exchange_n( ptr_, &expected, desired, false, success, failure );
     }
     else if constexpr ( Impl::atomic_use_cast_ops_v<T> ) {
@@ -573,8 +1230,330 @@ public:
   {
     return compare_exchange_strong( expected, desired, order, order );
   }
+
+  // Blocks until the value is observed to differ from old, comparing
+  // object representations.  Spins briefly before sleeping.
+  ATOMIC_REF_FORCEINLINE
+  void wait( value_type old
+           , std::memory_order order = std::memory_order_seq_cst
+           ) const noexcept
+  {
+    for (int i = 0; i < 16; ++i) {
+      const value_type current = load( order );
+      if ( std::memcmp( &current, &old, sizeof(T) ) != 0 ) {
+        return;
+      }
+      Impl::atomic_pause();
+    }
+    Impl::atomic_wait( ptr_, old, [this, order]() { return load( order ); } );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void notify_one() const noexcept
+  {
+    Impl::atomic_notify( ptr_, false );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void notify_all() const noexcept
+  {
+    Impl::atomic_notify( ptr_, true );
+  }
+
+  // Replaces the value v by f(v) in a compare-exchange loop with
+  // BackoffPolicy and returns v.  Nothing is written if f(v) has the same object
+  // representation as v, e.g. when fetch_max finds a larger value already.
+  template < class F >
+  ATOMIC_REF_FORCEINLINE
+  value_type fetch_update( F f
+                         , std::memory_order order = std::memory_order_seq_cst
+                         ) const
+  {
+    const std::memory_order failure = Impl::atomic_failure_order( order );
+
+    BackoffPolicy backoff;
+    value_type expected = load( failure );
+
+    while (true) {
+      const value_type desired = f( static_cast<const value_type&>(expected) );
+      if ( std::memcmp( &desired, &expected, sizeof(T) ) == 0 ) {
+        return expected;
+      }
+      if ( compare_exchange_weak( expected, desired, order, failure ) ) {
+        return expected;
+      }
+      backoff( ptr_ );
+    }
+  }
 };
 
+//------------------------------------------------------------------------------
+// atomic_ref_bound: atomic_ref whose operations all use MemoryOrder (P2689)
+//
+// loads use the acquire half and stores the release half of acq_rel.
+// Arithmetic and bitwise operations exist exactly when they exist on
+// atomic_ref<T>, and the operators use MemoryOrder, so that e.g.
+// atomic_ref_bound<int, std::memory_order_relaxed>(x) += 1 is a relaxed RMW.
+//------------------------------------------------------------------------------
+template < class T, std::memory_order MemoryOrder, class BackoffPolicy = backoff_exponential >
+struct atomic_ref_bound
+{
+private:
+  using atomic_ref_unbound = atomic_ref<T, BackoffPolicy>;
+
+  atomic_ref_unbound ref_;
+
+  static constexpr std::memory_order store_ordering = MemoryOrder == std::memory_order_acq_rel
+                                                      ? std::memory_order_release
+                                                      : MemoryOrder
+                                                      ;
+
+  static constexpr std::memory_order load_ordering = MemoryOrder == std::memory_order_acq_rel
+                                                     ? std::memory_order_acquire
+                                                     : MemoryOrder
+                                                     ;
+
+public:
+
+  using value_type = T;
+  using backoff_policy = BackoffPolicy;
+
+  static constexpr std::memory_order memory_ordering = MemoryOrder;
+  static constexpr size_t required_alignment  = atomic_ref_unbound::required_alignment;
+  static constexpr bool   is_always_lock_free = atomic_ref_unbound::is_always_lock_free;
+
+  atomic_ref_bound() = delete;
+  atomic_ref_bound & operator=( const atomic_ref_bound & ) = delete;
+
+  ATOMIC_REF_FORCEINLINE
+  explicit atomic_ref_bound( value_type & obj )
+    : ref_{obj}
+  {}
+
+  ATOMIC_REF_FORCEINLINE
+  atomic_ref_bound( const atomic_ref_bound & ref ) noexcept = default;
+
+  ATOMIC_REF_FORCEINLINE
+  value_type operator=( value_type desired ) const noexcept
+  {
+    store(desired);
+    return desired;
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  operator value_type() const noexcept
+  {
+    return load();
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  bool is_lock_free() const noexcept
+  {
+    return ref_.is_lock_free();
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void store( value_type desired ) const noexcept
+  {
+    ref_.store( desired, store_ordering );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  value_type load() const noexcept
+  {
+    return ref_.load( load_ordering );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  value_type exchange( value_type desired ) const noexcept
+  {
+    return ref_.exchange( desired, MemoryOrder );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  bool compare_exchange_weak( value_type& expected, value_type desired ) const noexcept
+  {
+    return ref_.compare_exchange_weak( expected, desired, MemoryOrder, load_ordering );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  bool compare_exchange_strong( value_type& expected, value_type desired ) const noexcept
+  {
+    return ref_.compare_exchange_strong( expected, desired, MemoryOrder, load_ordering );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_add( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_add( val, MemoryOrder ) )
+  {
+    return ref_.fetch_add( val, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_sub( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_sub( val, MemoryOrder ) )
+  {
+    return ref_.fetch_sub( val, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_and( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_and( val, MemoryOrder ) )
+  {
+    return ref_.fetch_and( val, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_or( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_or( val, MemoryOrder ) )
+  {
+    return ref_.fetch_or( val, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_xor( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_xor( val, MemoryOrder ) )
+  {
+    return ref_.fetch_xor( val, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_min( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_min( val, MemoryOrder ) )
+  {
+    return ref_.fetch_min( val, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto fetch_max( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_max( val, MemoryOrder ) )
+  {
+    return ref_.fetch_max( val, MemoryOrder );
+  }
+
+  template < class F >
+  ATOMIC_REF_FORCEINLINE
+  value_type fetch_update( F f ) const
+  {
+    return ref_.fetch_update( f, MemoryOrder );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void wait( value_type old ) const noexcept
+  {
+    ref_.wait( old, load_ordering );
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void notify_one() const noexcept
+  {
+    ref_.notify_one();
+  }
+
+  ATOMIC_REF_FORCEINLINE
+  void notify_all() const noexcept
+  {
+    ref_.notify_all();
+  }
+
+  // increment and decrement are not provided for floating-point types
+  template < class Ref = atomic_ref_unbound
+           , class = std::enable_if_t< !std::is_floating_point_v<typename Ref::value_type> >
+           >
+  ATOMIC_REF_FORCEINLINE
+  auto operator++(int) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_add( 1, MemoryOrder ) )
+  {
+    return ref_.fetch_add( 1, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound
+           , class = std::enable_if_t< !std::is_floating_point_v<typename Ref::value_type> >
+           >
+  ATOMIC_REF_FORCEINLINE
+  auto operator--(int) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_sub( 1, MemoryOrder ) )
+  {
+    return ref_.fetch_sub( 1, MemoryOrder );
+  }
+
+  template < class Ref = atomic_ref_unbound
+           , class = std::enable_if_t< !std::is_floating_point_v<typename Ref::value_type> >
+           >
+  ATOMIC_REF_FORCEINLINE
+  auto operator++() const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_add( 1, MemoryOrder ) )
+  {
+    return ref_.fetch_add( 1, MemoryOrder ) + 1;
+  }
+
+  template < class Ref = atomic_ref_unbound
+           , class = std::enable_if_t< !std::is_floating_point_v<typename Ref::value_type> >
+           >
+  ATOMIC_REF_FORCEINLINE
+  auto operator--() const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_sub( 1, MemoryOrder ) )
+  {
+    return ref_.fetch_sub( 1, MemoryOrder ) - 1;
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto operator+=( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_add( val, MemoryOrder ) )
+  {
+    return ref_.fetch_add( val, MemoryOrder ) + val;
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto operator-=( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_sub( val, MemoryOrder ) )
+  {
+    return ref_.fetch_sub( val, MemoryOrder ) - val;
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto operator&=( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_and( val, MemoryOrder ) )
+  {
+    return ref_.fetch_and( val, MemoryOrder ) & val;
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto operator|=( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_or( val, MemoryOrder ) )
+  {
+    return ref_.fetch_or( val, MemoryOrder ) | val;
+  }
+
+  template < class Ref = atomic_ref_unbound >
+  ATOMIC_REF_FORCEINLINE
+  auto operator^=( typename Ref::difference_type val ) const noexcept
+    -> decltype( std::declval<const Ref&>().fetch_xor( val, MemoryOrder ) )
+  {
+    return ref_.fetch_xor( val, MemoryOrder ) ^ val;
+  }
+};
+
+template < class T >
+using atomic_ref_relaxed = atomic_ref_bound< T, std::memory_order_relaxed >;
+
+template < class T >
+using atomic_ref_acq_rel = atomic_ref_bound< T, std::memory_order_acq_rel >;
+
+template < class T >
+using atomic_ref_seq_cst = atomic_ref_bound< T, std::memory_order_seq_cst >;
+
 } // namespace Foo
 
 
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "atomic_ref.hpp"
+
+// Throughput of floating-point atomic_ref::fetch_add vs thread count,
+// with all threads adding to one value (contended) or each thread adding
+// to its own cache line (uncontended).  The cas column is a
+// compare_exchange_weak loop on the value, for comparison.  The last table
+// compares the backoff policies of fetch_update under contention.
+//
+// usage: atomic_ref_bench [max threads] [adds per thread]
+// may need to link with -latomic and -pthread
+
+namespace {
+
+template <class T>
+struct alignas(64) padded
+{
+  T value;
+};
+
+template <class T>
+void fetch_add_loop(T& value, long n)
+{
+  Foo::atomic_ref<T> ref{value};
+  for (long i = 0; i < n; ++i) {
+    ref.fetch_add( T(1), std::memory_order_relaxed );
+  }
+}
+
+template <class T>
+void cas_loop(T& value, long n)
+{
+  Foo::atomic_ref<T> ref{value};
+  for (long i = 0; i < n; ++i) {
+    T expected = ref.load( std::memory_order_relaxed );
+    while ( !ref.compare_exchange_weak( expected
+                                      , expected + T(1)
+                                      , std::memory_order_relaxed
+                                      , std::memory_order_relaxed
+                                      )
+          ) {}
+  }
+}
+
+// always a compare-exchange loop, also with native floating-point adds
+template <class T, class BackoffPolicy>
+void fetch_update_loop(T& value, long n)
+{
+  Foo::atomic_ref<T, BackoffPolicy> ref{value};
+  for (long i = 0; i < n; ++i) {
+    ref.fetch_update( []( T v ) { return v + T(1); }, std::memory_order_relaxed );
+  }
+}
+
+// returns millions of adds per second
+template <class T>
+double run(void (*loop)(T&, long), int num_threads, long n, bool contended)
+{
+  std::vector<padded<T>> values(num_threads, padded<T>{T(0)});
+  std::vector<std::thread> threads;
+
+  const auto begin = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back( loop, std::ref( values[contended ? 0 : t].value ), n );
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - begin).count();
+  return 1e-6 * num_threads * n / seconds;
+}
+
+template <class T>
+void bench(const char* name, int max_threads, long n)
+{
+  printf("%s: Madds/s\n", name);
+  printf("%8s %14s %14s %14s %14s\n", "threads", "contended", "contended-cas", "private", "private-cas");
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    printf( "%8d %14.2f %14.2f %14.2f %14.2f\n"
+          , num_threads
+          , run<T>( fetch_add_loop<T>, num_threads, n, true )
+          , run<T>( cas_loop<T>, num_threads, n, true )
+          , run<T>( fetch_add_loop<T>, num_threads, n, false )
+          , run<T>( cas_loop<T>, num_threads, n, false )
+          );
+  }
+}
+
+template <class T>
+void bench_backoff(const char* name, int max_threads, long n)
+{
+  printf("%s fetch_update, contended: Madds/s\n", name);
+  printf("%8s %14s %14s %14s %14s\n", "threads", "none", "pause", "exponential", "sleep");
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    printf( "%8d %14.2f %14.2f %14.2f %14.2f\n"
+          , num_threads
+          , run<T>( fetch_update_loop<T, Foo::backoff_none>, num_threads, n, true )
+          , run<T>( fetch_update_loop<T, Foo::backoff_pause>, num_threads, n, true )
+          , run<T>( fetch_update_loop<T, Foo::backoff_exponential>, num_threads, n, true )
+          , run<T>( fetch_update_loop<T, Foo::backoff_sleep>, num_threads, n, true )
+          );
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const int max_threads = argc > 1 ? std::atoi(argv[1]) : int(std::thread::hardware_concurrency());
+  const long n = argc > 2 ? std::atol(argv[2]) : 1000000;
+
+  printf("native float ops: %d\n", ATOMIC_REF_NATIVE_FLOAT_OPS);
+  bench<float>( "float", max_threads, n );
+  bench<double>( "double", max_threads, n );
+  bench_backoff<float>( "float", max_threads, n );
+
+  return 0;
+}
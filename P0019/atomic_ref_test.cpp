@@ -1,13 +1,77 @@
 #include <cstdio>
 #include <complex>
 #include <array>
+#include <thread>
+#include <vector>
 
 #include "atomic_ref.hpp"
 
-// may need to link with -latomic
+// may need to link with -latomic and -pthread
 
 namespace {
 
+// 32 byte record using the lock pool customization points
+struct bbox
+{
+  float lo[4];
+  float hi[4];
+
+  bool operator!=( const bbox & other ) const
+  {
+    for (int i = 0; i < 4; ++i) {
+      if ( lo[i] != other.lo[i] || hi[i] != other.hi[i] ) return true;
+    }
+    return false;
+  }
+};
+
+void lock_reference( bbox & b )   { Foo::lock_pool::global().lock( &b ); }
+void unlock_reference( bbox & b ) { Foo::lock_pool::global().unlock( &b ); }
+
+// grows a shared box from several threads, every update replaces the
+// whole record
+int test_lock_pool()
+{
+  int errors = 0;
+
+  static_assert( Foo::Impl::atomic_use_lock_reference_v<bbox>
+               , "bbox should use the lock pool" );
+
+  constexpr int num_threads = 4;
+  constexpr int num_updates = 10000;
+
+  bbox box{ {0,0,0,0}, {0,0,0,0} };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back( [&box]() {
+      Foo::atomic_ref<bbox> ref{box};
+      for (int i = 0; i < num_updates; ++i) {
+        bbox expected = ref.load();
+        bbox desired;
+        do {
+          desired = expected;
+          for (int d = 0; d < 4; ++d) {
+            desired.lo[d] -= 1;
+            desired.hi[d] += 1;
+          }
+        } while ( !ref.compare_exchange_weak( expected, desired ) );
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int d = 0; d < 4; ++d) {
+    if ( box.lo[d] != -num_threads*num_updates || box.hi[d] != num_threads*num_updates ) {
+      ++errors;
+    }
+  }
+
+  return errors;
+}
+
 template <class T>
 int test_generic(T v1, T v2)
 {
@@ -77,6 +141,29 @@ int test_integral(T a, T b)
   ref &= b;
   ref ^= b;
 
+  ref = b | 1;
+  if ( b != (ref &= b) ) {
+    ++errors;
+  }
+
+  // ref refers to a, so use another object for the value checks
+  const T lo = 1, hi = 64;
+  T c = hi;
+  atomic_ref cref(c);
+
+  if ( hi != cref.fetch_min( lo ) || lo != cref.load() ) {
+    ++errors;
+  }
+  if ( lo != cref.fetch_min( hi ) || lo != cref.load() ) {
+    ++errors;
+  }
+  if ( lo != cref.fetch_max( hi, std::memory_order_relaxed ) || hi != cref.load() ) {
+    ++errors;
+  }
+  if ( hi != cref.fetch_update( [lo]( T v ) { return T( v ^ lo ); } ) || T( hi ^ lo ) != cref.load() ) {
+    ++errors;
+  }
+
   ref.fetch_add(b, std::memory_order_relaxed );
   ref.fetch_sub(b, std::memory_order_relaxed );
   ref.fetch_and(b, std::memory_order_relaxed );
@@ -101,6 +188,20 @@ int test_float(T a, T b)
   ref.fetch_add(b, std::memory_order_relaxed );
   ref.fetch_sub(b, std::memory_order_relaxed );
 
+  const T lo = 1, hi = 64;
+  T c = hi;
+  atomic_ref cref(c);
+
+  if ( hi != cref.fetch_min( lo ) || lo != cref.load() ) {
+    ++errors;
+  }
+  if ( lo != cref.fetch_max( hi, std::memory_order_acq_rel ) || hi != cref.load() ) {
+    ++errors;
+  }
+  if ( hi != cref.fetch_max( lo ) || hi != cref.load() ) {
+    ++errors;
+  }
+
   ref.fetch_add( std::nan("") );
 
   errors += std::isnan( ref.load() ) ? 0 : 1;
@@ -126,6 +227,169 @@ int test_pointer(T a, uintptr_t b)
   return errors;
 }
 
+// pointer + counter pair, as used by lock-free stacks to avoid ABA
+struct alignas(16) tagged_ptr
+{
+  void *   ptr;
+  uint64_t tag;
+
+  bool operator!=( const tagged_ptr & other ) const
+  {
+    return ptr != other.ptr || tag != other.tag;
+  }
+};
+
+int test_tagged_ptr()
+{
+  int errors = 0;
+
+  constexpr int num_threads = 4;
+  constexpr int num_updates = 10000;
+
+  int objects[2] = {};
+  tagged_ptr head{ &objects[0], 0 };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back( [&head, &objects]() {
+      Foo::atomic_ref<tagged_ptr> ref{head};
+      tagged_ptr expected = ref.load();
+      for (int i = 0; i < num_updates; ++i) {
+        tagged_ptr desired;
+        do {
+          desired.ptr = expected.ptr == &objects[0] ? &objects[1] : &objects[0];
+          desired.tag = expected.tag + 1;
+        } while ( !ref.compare_exchange_weak( expected, desired ) );
+        expected = desired;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if ( head.tag != uint64_t(num_threads) * num_updates || head.ptr != &objects[0] ) {
+    ++errors;
+  }
+
+  return errors;
+}
+
+// concurrent float adds and max updates retried with BackoffPolicy
+template <class BackoffPolicy>
+int test_backoff()
+{
+  int errors = 0;
+
+  constexpr int num_threads = 4;
+  constexpr int num_updates = 10000;
+
+  float sum = 0;
+  int max = 0;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back( [&sum, &max, t]() {
+      Foo::atomic_ref<float, BackoffPolicy> sum_ref{sum};
+      Foo::atomic_ref<int, BackoffPolicy> max_ref{max};
+      for (int i = 0; i < num_updates; ++i) {
+        sum_ref.fetch_add( 1.0f, std::memory_order_relaxed );
+        max_ref.fetch_max( i * num_threads + t, std::memory_order_relaxed );
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if ( sum != float(num_threads * num_updates) || max != num_threads * num_updates - 1 ) {
+    ++errors;
+  }
+
+  return errors;
+}
+
+// consumers block on a flag until the producer publishes the value
+template <class T>
+int test_wait(T unset, T set)
+{
+  int errors = 0;
+
+  constexpr int num_consumers = 3;
+
+  T flag = unset;
+  int payload = 0;
+  std::atomic<int> seen{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_consumers; ++t) {
+    threads.emplace_back( [&]() {
+      Foo::atomic_ref<T> ref{flag};
+      ref.wait( unset, std::memory_order_acquire );
+      seen.fetch_add( payload, std::memory_order_relaxed );
+    });
+  }
+
+  payload = 1;
+  Foo::atomic_ref<T> ref{flag};
+  ref.store( set, std::memory_order_release );
+  ref.notify_all();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if ( seen.load() != num_consumers ) {
+    ++errors;
+  }
+
+  // returns immediately when the value already differs
+  ref.wait( unset );
+  ref.notify_one();
+
+  return errors;
+}
+
+template <template <class> class AtomicRefBound, class T>
+int test_bound(T v1, T v2)
+{
+  using atomic_ref = AtomicRefBound<T>;
+
+  int errors = 0;
+
+  T val = v1;
+
+  atomic_ref ref{val};
+
+  if ( v1 != ref.exchange(v2) ) {
+    ++errors;
+  }
+
+  ref = v1;
+  if ( v1 != ref.load() ) {
+    ++errors;
+  }
+
+  T expected = v2;
+  if( ref.compare_exchange_strong(expected, v2) || expected != v1 ) {
+    ++errors;
+  }
+
+  if ( v1 != ref.fetch_add(v2) || v1 + v2 != static_cast<T>(ref) ) {
+    ++errors;
+  }
+
+  if ( v1 != (ref -= v2) ) {
+    ++errors;
+  }
+
+  if ( v1 != ref.fetch_max(v2) || v2 != ref.fetch_update( [v1]( T v ) { return v - v1; } ) ) {
+    ++errors;
+  }
+
+  return errors;
+}
+
 } // namespace
 
 int main()
@@ -274,6 +538,53 @@ int main()
     printf("lockfree[%s]: %d\n", "array<int,4>", Foo::atomic_ref<std::array<int,4>>::is_always_lock_free);
   }
 
+  {
+    int a = 1, b = 64;
+    tagged_ptr ta{ &a, 1 }, tb{ &b, 2 };
+
+    num_errors += test_generic( ta, tb );
+    num_errors += test_tagged_ptr();
+    printf("lockfree[%s]: %d (is_lock_free: %d)\n", "tagged_ptr"
+          , Foo::atomic_ref<tagged_ptr>::is_always_lock_free
+          , Foo::atomic_ref<tagged_ptr>{ta}.is_lock_free()
+          );
+  }
+
+  {
+    bbox a{ {0,0,0,0}, {1,1,1,1} }, b{ {-1,-1,-1,-1}, {2,2,2,2} };
+
+    num_errors += test_generic( a ,b );
+    num_errors += test_lock_pool();
+    printf("lockfree[%s]: %d\n", "bbox", Foo::atomic_ref<bbox>::is_always_lock_free);
+  }
+
+  {
+    int a = 1, b = 64;
+    num_errors += test_bound<Foo::atomic_ref_relaxed>( a, b );
+    num_errors += test_bound<Foo::atomic_ref_acq_rel>( a, b );
+    num_errors += test_bound<Foo::atomic_ref_seq_cst>( a, b );
+  }
+
+  {
+    double a = 1, b = 64;
+    num_errors += test_bound<Foo::atomic_ref_relaxed>( a, b );
+    num_errors += test_bound<Foo::atomic_ref_acq_rel>( a, b );
+    num_errors += test_bound<Foo::atomic_ref_seq_cst>( a, b );
+  }
+
+  num_errors += test_wait<int>( 0, 1 );
+  num_errors += test_wait<char>( 0, 1 );
+  num_errors += test_wait<double>( 0, 1 );
+  {
+    int a = 0, b = 0;
+    num_errors += test_wait<tagged_ptr>( tagged_ptr{ &a, 0 }, tagged_ptr{ &b, 1 } );
+  }
+
+  num_errors += test_backoff<Foo::backoff_none>();
+  num_errors += test_backoff<Foo::backoff_pause>();
+  num_errors += test_backoff<Foo::backoff_exponential>();
+  num_errors += test_backoff<Foo::backoff_sleep>();
+
   if (num_errors > 0) {
     printf("FAIL: num errors = = %d\n", num_errors );
   }
@@ -0,0 +1,70 @@
+
+#include <experimental/async_ptr>
+
+#if defined(ASYNC_PTR_USE_HPX_FOR_CONCURRENCY_TS)
+#include <hpx/hpx_main.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace std::experimental;
+using namespace std;
+
+// Cost of a borrow: runs a chain of n writing borrows of one async_ptr
+// (each waits for the one before it) and reports the calls to the global
+// operator new and the wall time per borrow, including waiting for the
+// whole chain when the pointer is destroyed.
+//
+//   bench_borrow [n]    (default 20000)
+
+std::atomic<long> news{0};
+
+void* operator new(std::size_t size) {
+  news.fetch_add(1, std::memory_order_relaxed);
+  if(void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+// (the default sized operator delete calls this one)
+void operator delete(void* p) noexcept { std::free(p); }
+
+std::atomic<long> total{0};
+
+void run_chain(long n) {
+  async_ptr<int> ptr;
+  ptr.set_value(0);
+  for(long i = 0; i < n; ++i) {
+    ptr.borrow_value_async([](int& value) {
+      ++value;
+      total.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  // the destructor waits for the chain
+}
+
+int main(int argc, char* argv[]) {
+  long const n = argc > 1 ? std::atol(argv[1]) : 20000;
+
+  // warm up the pool threads and the block caches
+  run_chain(n / 10 + 1);
+
+  total = 0;
+  long const news_before = news.load();
+  auto const start = std::chrono::steady_clock::now();
+  run_chain(n);
+  auto const stop = std::chrono::steady_clock::now();
+
+  if(total.load() != n) {
+    std::fprintf(stderr, "FAILED: %ld of %ld borrows ran\n", total.load(), n);
+    return 1;
+  }
+  std::printf("%ld borrows: %.2f allocations, %.2f us per borrow\n", n,
+    double(news.load() - news_before) / double(n),
+    std::chrono::duration<double, std::micro>(stop - start).count() / double(n)
+  );
+  return 0;
+}
@@ -0,0 +1,154 @@
+
+#include <experimental/detail/block_pool.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace std::experimental;
+using namespace std;
+
+// Tests of the per-thread block pools that async_ptr allocates its events,
+// continuations and pool tasks from. Calls to the global operator new and
+// delete are counted to tell blocks taken from a pool from fresh ones.
+
+std::atomic<long> news{0};
+std::atomic<long> deletes{0};
+
+void* operator new(std::size_t size) {
+  news.fetch_add(1, std::memory_order_relaxed);
+  if(void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  if(p) deletes.fetch_add(1, std::memory_order_relaxed);
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  if(p) deletes.fetch_add(1, std::memory_order_relaxed);
+  std::free(p);
+}
+
+void fail(char const* what) {
+  std::fprintf(stderr, "FAILED: %s\n", what);
+  std::fflush(stderr);
+  std::abort();
+}
+
+void check(bool cond, char const* what) {
+  if(not cond) fail(what);
+}
+
+using pool_t = detail::_fixed_block_pool<64>;
+
+//==============================================================================
+// Blocks freed on one thread are reused by it without operator new
+
+void test_same_thread_reuse() {
+  std::thread([]{
+    void* p = pool_t::allocate();
+    pool_t::deallocate(p);
+    long const before = news.load();
+    void* q = pool_t::allocate();
+    check(news.load() == before, "freed block not reused");
+    check(q == p, "most recently freed block not reused first");
+    pool_t::deallocate(q);
+  }).join();
+}
+
+//==============================================================================
+// Blocks allocated on one thread and freed on another go back, in batches,
+// through the shared depot to threads that allocate
+
+void test_cross_thread_batches() {
+  constexpr std::size_t n = 1024;
+  std::vector<void*> blocks(n);
+  std::thread([&]{
+    for(auto& p : blocks) p = pool_t::allocate();
+  }).join();
+
+  // all but at most two batches end up in the depot
+  std::thread([&]{
+    for(auto p : blocks) pool_t::deallocate(p);
+  }).join();
+
+  std::set<void*> const freed(blocks.begin(), blocks.end());
+  std::thread([&]{
+    // a new thread starts with an empty cache, so every block comes from
+    // the depot
+    std::vector<void*> again(n / 2);
+    long const before = news.load();
+    for(auto& p : again) p = pool_t::allocate();
+    check(news.load() == before, "blocks freed on another thread not reused");
+    for(auto p : again) check(freed.count(p) == 1, "block not from the depot");
+    for(auto p : again) pool_t::deallocate(p);
+  }).join();
+}
+
+//==============================================================================
+// Blocks freed (or allocated) by thread_local destructors that run after
+// the thread's cache is gone go straight to the global operator delete
+// (new). Run under AddressSanitizer to check that nothing is leaked or
+// freed twice.
+
+struct late_user {
+  void* block = nullptr;
+  ~late_user() {
+    long const before_delete = deletes.load();
+    pool_t::deallocate(block);
+    check(deletes.load() == before_delete + 1, "late free not returned to operator delete");
+    long const before_new = news.load();
+    void* p = pool_t::allocate();
+    check(news.load() == before_new + 1, "late allocation not from operator new");
+    pool_t::deallocate(p);
+  }
+};
+
+void test_after_thread_local_teardown() {
+  std::thread([]{
+    // constructed before the block cache, hence destroyed after it
+    thread_local late_user user;
+    user.block = pool_t::allocate();
+  }).join();
+}
+
+//==============================================================================
+// _pool_new picks a pool by size, and objects too large for any pool come
+// from operator new
+
+struct small_object { char data[40]; };
+struct large_object { char data[300]; };
+
+void test_pool_new() {
+  std::thread([]{
+    auto* s = detail::_pool_new<small_object>();
+    detail::_pool_delete(s);
+    long const before = news.load();
+    s = detail::_pool_new<small_object>();
+    check(news.load() == before, "small object not pooled");
+    detail::_pool_delete(s);
+
+    auto* l = detail::_pool_new<large_object>();
+    check(news.load() == before + 1, "large object not from operator new");
+    detail::_pool_delete(l);
+  }).join();
+}
+
+//==============================================================================
+// main
+
+int main() {
+  test_same_thread_reuse();
+  test_cross_thread_batches();
+  test_after_thread_local_teardown();
+  test_pool_new();
+
+  std::printf("SUCCESS\n");
+  return 0;
+}
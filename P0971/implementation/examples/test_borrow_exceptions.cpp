@@ -0,0 +1,159 @@
+
+#include <experimental/async_ptr>
+
+#if defined(ASYNC_PTR_USE_HPX_FOR_CONCURRENCY_TS)
+#include <hpx/hpx_main.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std::experimental;
+using namespace std;
+
+// Exceptions thrown by borrow callables. The callables run as pool tasks,
+// which must not throw; an exception is passed on to the pointer the value
+// was borrowed from instead, and release() on that pointer rethrows it.
+
+void fail(char const* what) {
+  std::fprintf(stderr, "FAILED: %s\n", what);
+  std::fflush(stderr);
+  std::abort();
+}
+
+void check(bool cond, char const* what) {
+  if(not cond) fail(what);
+}
+
+void start_watchdog(std::chrono::seconds limit) {
+  std::thread([limit]{
+    std::this_thread::sleep_for(limit);
+    fail("timed out");
+  }).detach();
+}
+
+// the message of the exception release() throws, or "" if it doesn't
+template <typename Ptr>
+std::string release_error(Ptr& ptr) {
+  try {
+    ptr.release();
+  }
+  catch(std::runtime_error const& e) {
+    return e.what();
+  }
+  return "";
+}
+
+//==============================================================================
+// Each kind of borrow
+
+void test_borrow_kinds() {
+  {
+    auto ptr = make_async_ptr<int>(0);
+    ptr.borrow_async([](auto) { throw std::runtime_error("borrow"); });
+    check(release_error(ptr) == "borrow", "borrow_async exception not rethrown");
+  }
+  {
+    auto ptr = make_async_ptr<int>(0);
+    ptr.borrow_value_async([](int&) { throw std::runtime_error("value"); });
+    check(release_error(ptr) == "value", "borrow_value_async exception not rethrown");
+  }
+  {
+    auto ptr = make_async_ptr<int>(0);
+    ptr.const_borrow_async([](auto) { throw std::runtime_error("const"); });
+    check(release_error(ptr) == "const", "const_borrow_async exception not rethrown");
+  }
+  {
+    auto ptr = make_async_ptr<int>(0);
+    ptr.const_borrow_value_async([](int const&) { throw std::runtime_error("const value"); });
+    check(release_error(ptr) == "const value", "const_borrow_value_async exception not rethrown");
+  }
+  {
+    // no exception, nothing thrown
+    auto ptr = make_async_ptr<int>(0);
+    ptr.borrow_value_async([](int& value) { ++value; });
+    check(release_error(ptr) == "", "release() threw without an exception");
+  }
+}
+
+//==============================================================================
+// Borrows queued behind a failed one still run, and the exception is not
+// lost when they complete
+
+void test_later_borrows() {
+  std::atomic<int> ran{0};
+  auto ptr = make_async_ptr<int>(0);
+  ptr.borrow_value_async([](int&) { throw std::runtime_error("first"); });
+  ptr.borrow_value_async([&](int&) { ++ran; throw std::runtime_error("second"); });
+  ptr.const_borrow_value_async([&](int const&) { ++ran; });
+  ptr.borrow_value_async([&](int&) { ++ran; });
+  check(release_error(ptr) == "first", "first exception not kept");
+  check(ran == 3, "borrows after a failed one did not run");
+}
+
+//==============================================================================
+// Nested borrows pass the exception out to the outermost pointer
+
+void test_nested() {
+  auto ptr = make_async_ptr<int>(0);
+  ptr.borrow_async([](auto borrowed) {
+    borrowed.borrow_async([](auto inner) {
+      inner.const_borrow_value_async([](int const&) { throw std::runtime_error("inner"); });
+    });
+  });
+  check(release_error(ptr) == "inner", "nested exception not passed out");
+}
+
+//==============================================================================
+// with_all: the exception reaches every pointer of the joint borrow
+
+void test_with_all() {
+  auto a = make_async_ptr<int>(1);
+  auto b = make_async_ptr<int>(2);
+  with_all(a, as_const(b)).borrow_async([](auto, auto) { throw std::runtime_error("joint"); });
+  check(release_error(a) == "joint", "with_all exception not passed to the first pointer");
+  check(release_error(b) == "joint", "with_all exception not passed to the second pointer");
+
+  auto c = make_async_ptr<int>(3);
+  auto d = make_async_ptr<int>(4);
+  with_all_values(c, d).borrow_async([](int&, int&) { throw std::runtime_error("joint values"); });
+  check(release_error(c) == "joint values", "with_all_values exception not passed on");
+  check(release_error(d) == "joint values", "with_all_values exception not passed on");
+}
+
+//==============================================================================
+// Destroying a pointer whose borrow threw waits for it without throwing
+
+void test_destructor() {
+  std::atomic<bool> ran{false};
+  {
+    auto ptr = make_async_ptr<int>(0);
+    ptr.borrow_value_async([&](int&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      ran = true;
+      throw std::runtime_error("dropped");
+    });
+  }
+  check(ran, "destructor did not wait for the borrow");
+}
+
+//==============================================================================
+// main
+
+int main() {
+  start_watchdog(std::chrono::seconds(30));
+
+  test_borrow_kinds();
+  test_later_borrows();
+  test_nested();
+  test_with_all();
+  test_destructor();
+
+  std::printf("SUCCESS\n");
+  return 0;
+}
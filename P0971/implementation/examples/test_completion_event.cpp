@@ -0,0 +1,202 @@
+
+#include <experimental/detail/completion_event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::experimental;
+using namespace std;
+
+// Tests of the completion events that async_ptr uses in place of
+// promise<void>/shared_future<void>.
+
+using detail::_event_future;
+using detail::_event_promise;
+
+void fail(char const* what) {
+  std::fprintf(stderr, "FAILED: %s\n", what);
+  std::fflush(stderr);
+  std::abort();
+}
+
+void check(bool cond, char const* what) {
+  if(not cond) fail(what);
+}
+
+void start_watchdog(std::chrono::seconds limit) {
+  std::thread([limit]{
+    std::this_thread::sleep_for(limit);
+    fail("timed out");
+  }).detach();
+}
+
+// the message of the exception get() throws, or "" if it doesn't
+std::string get_error(_event_future const& f) {
+  try {
+    f.get();
+  }
+  catch(std::runtime_error const& e) {
+    return e.what();
+  }
+  return "";
+}
+
+//==============================================================================
+// The event completes when the last copy of its promise goes away, and runs
+// its continuations then, oldest first
+
+void test_producer_countdown() {
+  check(_event_future().is_ready(), "null future not ready");
+
+  auto p1 = _event_promise::make();
+  auto f = p1.get_future();
+  auto p2 = p1;
+  auto p3 = p2;
+
+  std::vector<int> order;
+  f.then([&]{ order.push_back(1); });
+  f.then([&]{ order.push_back(2); });
+
+  p1 = nullptr;
+  check(not f.is_ready(), "completed with two producers left");
+  p3 = nullptr;
+  check(not f.is_ready(), "completed with one producer left");
+  check(order.empty(), "continuation ran early");
+  p2 = nullptr;
+  check(f.is_ready(), "not completed after the last producer");
+  check(order == std::vector<int>({1, 2}), "continuations not run oldest first");
+
+  // added after completion: runs right away
+  f.then([&]{ order.push_back(3); });
+  check(order.size() == 3, "continuation on a complete event did not run");
+  f.get();
+}
+
+//==============================================================================
+// Exceptions: the first one set is kept, the event still waits for all of
+// its producers, and a chained event passes its exception on to the event
+// it was chained from
+
+void test_exceptions() {
+  {
+    auto p = _event_promise::make();
+    auto f = p.get_future();
+    auto p2 = p;
+    p.set_exception(std::make_exception_ptr(std::runtime_error("first")));
+    p2.set_exception(std::make_exception_ptr(std::runtime_error("second")));
+    p = nullptr;
+    check(not f.is_ready(), "exception completed the event early");
+    p2 = nullptr;
+    check(get_error(f) == "first", "first exception not kept");
+  }
+  {
+    auto parent = _event_promise::make();
+    auto parent_future = parent.get_future();
+    auto child = _event_promise::make(std::move(parent));
+    auto child_future = child.get_future();
+    check(not parent_future.is_ready(), "parent completed before its chained event");
+    child.set_exception(std::make_exception_ptr(std::runtime_error("child")));
+    child = nullptr;
+    check(get_error(child_future) == "child", "chained event lost its exception");
+    check(get_error(parent_future) == "child", "exception not passed to the parent");
+  }
+}
+
+//==============================================================================
+// _when_all completes once its last pending input has, with the exception of
+// an input, and a long chain of joins completes without recursing once per
+// link
+
+void test_when_all() {
+  check(_when_all(_event_future(), _event_future()).is_ready(), "join of null futures not ready");
+  {
+    auto p1 = _event_promise::make();
+    auto p2 = _event_promise::make();
+    auto p3 = _event_promise::make();
+    auto f = _when_all(p1.get_future(), _event_future(), p2.get_future(), p3.get_future());
+    p2 = nullptr;
+    p1 = nullptr;
+    check(not f.is_ready(), "join completed before its last input");
+    p3.set_exception(std::make_exception_ptr(std::runtime_error("input")));
+    p3 = nullptr;
+    check(get_error(f) == "input", "exception of an input not propagated");
+  }
+  {
+    constexpr int n = 200000;
+    auto first = _event_promise::make();
+    _event_future f = first.get_future();
+    std::vector<_event_promise> links;
+    links.reserve(n);
+    for(int i = 0; i < n; ++i) {
+      links.push_back(_event_promise::make());
+      f = _when_all(f, links.back().get_future());
+    }
+    links.clear();
+    check(not f.is_ready(), "chain of joins completed early");
+    first = nullptr;
+    check(f.is_ready(), "chain of joins not completed");
+  }
+}
+
+//==============================================================================
+// A pool thread that waits on an event keeps running pool work, so waiting
+// for work queued behind it doesn't deadlock even when every thread of the
+// pool is waiting
+
+void test_wait_on_pool_thread() {
+  auto& pool = detail::_async_ptr_default_pool();
+  std::size_t const n = 4 * pool.num_threads();
+  std::atomic<std::size_t> done{0};
+  for(std::size_t i = 0; i < n; ++i) {
+    pool.submit([&]{
+      auto p = _event_promise::make();
+      auto f = p.get_future();
+      pool.submit([p=std::move(p)]{ });
+      f.wait();
+      check(f.is_ready(), "wait() returned early");
+      ++done;
+    });
+  }
+  while(done.load() != n) std::this_thread::yield();
+}
+
+//==============================================================================
+// A thread outside the pool blocks in wait() until another thread
+// completes the event
+
+void test_wait_off_pool() {
+  auto p = _event_promise::make();
+  auto f = p.get_future();
+  std::atomic<bool> completed{false};
+  std::thread t([&, p=std::move(p)]() mutable {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    completed = true;
+    p = nullptr;
+  });
+  f.wait();
+  check(completed, "wait() returned before the event completed");
+  t.join();
+}
+
+//==============================================================================
+// main
+
+int main() {
+  start_watchdog(std::chrono::seconds(30));
+
+  test_producer_countdown();
+  test_exceptions();
+  test_when_all();
+  test_wait_on_pool_thread();
+  test_wait_off_pool();
+
+  std::printf("SUCCESS\n");
+  return 0;
+}
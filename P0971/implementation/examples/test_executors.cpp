@@ -12,12 +12,127 @@
 #include <iostream>
 #include <utility>
 #include <cstdlib>
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <thread> // for sleeping; seems to work well enough with boost::thread
 
 using namespace std::experimental;
 using namespace std;
 
+void fail(char const* what) {
+  std::fprintf(stderr, "FAILED: %s\n", what);
+  std::fflush(stderr);
+  std::abort();
+}
+
+void check(bool cond, char const* what) {
+  if(not cond) fail(what);
+}
+
+//==============================================================================
+// bulk_execute
+
+// Every index of [0, n) runs exactly once, and the shared state is the one
+// made by the factory
+template <typename Executor>
+void check_bulk_once(Executor ex, std::size_t n, char const* what) {
+  std::vector<std::atomic<int>> counts(n);
+  std::atomic<long> sum{0};
+  ex.bulk_execute(
+    [&](std::size_t i, long& scale) {
+      counts[i].fetch_add(1, std::memory_order_relaxed);
+      sum.fetch_add(long(i) * scale, std::memory_order_relaxed);
+    },
+    n, []{ return 3L; }
+  );
+  for(auto& c : counts) check(c.load() == 1, what);
+  check(sum.load() == 3L * long(n) * (long(n) - 1) / 2, what);
+}
+
+void test_bulk_partitions(static_thread_pool& pool) {
+  auto ex = pool.executor().require(execution::bulk);
+  for(std::size_t n : { 0, 1, 7, 1000, 100003 }) {
+    check_bulk_once(ex, n, "default partition");
+    check_bulk_once(ex.require(execution::bulk_static), n, "bulk_static");
+    check_bulk_once(ex.require(execution::bulk_static_t{5}), n, "bulk_static, chunk size 5");
+    check_bulk_once(ex.require(execution::bulk_dynamic), n, "bulk_dynamic");
+    check_bulk_once(ex.require(execution::bulk_dynamic_t{64}), n, "bulk_dynamic, chunk size 64");
+    check_bulk_once(ex.require(execution::bulk_guided), n, "bulk_guided");
+    check_bulk_once(ex.require(execution::bulk_guided_t{16}), n, "bulk_guided, chunk size 16");
+    // a chunk larger than the shape
+    check_bulk_once(ex.require(execution::bulk_dynamic_t{1u << 20}), n, "bulk_dynamic, one chunk");
+  }
+}
+
+// Any type with a static rank() and extent(r), such as
+// std::experimental::extents
+struct extents_3d {
+  std::size_t e[3];
+  static constexpr std::size_t rank() noexcept { return 3; }
+  constexpr std::size_t extent(std::size_t r) const noexcept { return e[r]; }
+};
+
+void test_bulk_nd(static_thread_pool& pool) {
+  auto ex = pool.executor().require(execution::bulk);
+  extents_3d const shape = { { 5, 7, 11 } };
+  for(auto partitioned : { ex, ex.require(execution::bulk_dynamic_t{3}), ex.require(execution::bulk_guided) }) {
+    std::vector<std::atomic<int>> counts(5 * 7 * 11);
+    std::atomic<long> sum{0};
+    partitioned.bulk_execute(
+      [&](std::size_t i, std::size_t j, std::size_t k, int& shared) {
+        check(i < 5 and j < 7 and k < 11, "rank-3 index out of range");
+        counts[(i * 7 + j) * 11 + k].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(long(i + j + k) * shared, std::memory_order_relaxed);
+      },
+      shape, []{ return 2; }
+    );
+    for(auto& c : counts) check(c.load() == 1, "rank-3 index not run exactly once");
+    // every value of i appears 7 * 11 times, and so on
+    long const expected = 2 * (7L * 11 * (0+1+2+3+4) + 5L * 11 * (0+1+2+3+4+5+6) + 5L * 7 * 55);
+    check(sum.load() == expected, "rank-3 sum");
+  }
+}
+
+void test_bulk_rethrow(static_thread_pool& pool) {
+  auto ex = pool.executor().require(execution::bulk).require(execution::bulk_dynamic_t{1});
+  bool caught = false;
+  try {
+    ex.bulk_execute(
+      [](std::size_t i, int&) { if(i == 500) throw std::out_of_range("index 500"); },
+      1000, []{ return 0; }
+    );
+  }
+  catch(std::out_of_range const& e) {
+    caught = std::string(e.what()) == "index 500";
+  }
+  check(caught, "exception from bulk_execute body was not rethrown");
+
+  // the pool is still usable afterwards
+  check_bulk_once(ex, 1000, "bulk_execute after an exception");
+}
+
+// A bulk_execute from inside a pool task joins by running other pool work,
+// so it completes even when every thread of the pool is inside one
+void test_bulk_nested(static_thread_pool& pool, std::size_t num_threads) {
+  auto ex = pool.executor();
+  std::vector<future<void>> outer;
+  for(std::size_t t = 0; t < 2 * num_threads; ++t) {
+    outer.push_back(ex.twoway_execute([ex]() mutable {
+      check_bulk_once(ex.require(execution::bulk).require(execution::bulk_dynamic_t{8}), 5000,
+        "bulk_execute nested in a pool task"
+      );
+    }));
+  }
+  for(auto& f : outer) f.get();
+}
+
+//==============================================================================
+// main
+
 int main() {
   static_thread_pool pool(1);
   {
@@ -34,10 +149,29 @@ int main() {
 
     //t.wait();
 
+    // one fork-join over 1000 indices, chunks handed out dynamically
+    std::atomic<int> sum{0};
+    ex.require(execution::bulk).require(execution::bulk_dynamic_t{64}).bulk_execute(
+      [&sum](std::size_t i, int& scale) { sum += int(i) * scale; },
+      1000, []{ return 2; }
+    );
+    std::cout << sum << std::endl;
+
   }
 
   pool.wait();
 
+  {
+    std::size_t const num_threads = 4;
+    static_thread_pool bulk_pool(num_threads);
+    test_bulk_partitions(bulk_pool);
+    test_bulk_nd(bulk_pool);
+    test_bulk_rethrow(bulk_pool);
+    test_bulk_nested(bulk_pool, num_threads);
+    bulk_pool.wait();
+  }
+
+  std::printf("SUCCESS\n");
   return 0;
 }
 
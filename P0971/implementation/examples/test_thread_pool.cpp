@@ -0,0 +1,163 @@
+
+#include <experimental/future>
+#include <experimental/execution>
+#include <experimental/thread_pool>
+#include <experimental/detail/work_stealing_pool.hpp>
+
+#if defined(ASYNC_PTR_USE_HPX_FOR_CONCURRENCY_TS)
+#include <hpx/hpx_main.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace std::experimental;
+using namespace std;
+
+// Tests of the work-stealing pool behind static_thread_pool. A watchdog
+// fails the test instead of letting a lost wakeup or a miscounted pool
+// hang forever.
+
+void fail(char const* what) {
+  std::fprintf(stderr, "FAILED: %s\n", what);
+  std::fflush(stderr);
+  std::abort();
+}
+
+void check(bool cond, char const* what) {
+  if(not cond) fail(what);
+}
+
+void start_watchdog(std::chrono::seconds limit) {
+  std::thread([limit]{
+    std::this_thread::sleep_for(limit);
+    fail("timed out");
+  }).detach();
+}
+
+template <typename Pred>
+void spin_until(Pred const& pred) {
+  while(not pred()) std::this_thread::yield();
+}
+
+//==============================================================================
+// A task of pool a, run by a worker of pool b through a.try_executing_one()
+// (as the join of a bulk_execute on a does), submits more work to a. That
+// work must go to a, not onto the deque of b's worker.
+
+void test_try_executing_one_from_other_pool() {
+  using pool_t = detail::_work_stealing_pool;
+  auto* a = new pool_t(1);
+  auto* b = new pool_t(1);
+
+  // keep a's only worker busy, so that the next task stays queued on a
+  std::atomic<bool> release_a{false};
+  std::atomic<bool> a_blocked{false};
+  a->submit([&]{
+    a_blocked = true;
+    spin_until([&]{ return release_a.load(); });
+  });
+  spin_until([&]{ return a_blocked.load(); });
+
+  std::atomic<bool> outer_ran{false};
+  std::atomic<int> inner_ran_on{0}; // 1: a, 2: b, 3: neither
+  a->submit([&]{
+    outer_ran = true;
+    a->submit([&]{
+      inner_ran_on = a->running_in_this_thread() and not b->running_in_this_thread() ? 1
+        : b->running_in_this_thread() ? 2 : 3;
+    });
+  });
+
+  std::atomic<bool> b_done{false};
+  b->submit([&]{
+    spin_until([&]{ return a->try_executing_one() or outer_ran.load(); });
+    b_done = true;
+  });
+  spin_until([&]{ return b_done.load(); });
+  check(outer_ran, "task of a was not run by b's worker");
+
+  release_a = true;
+  delete a;
+  delete b;
+  check(inner_ran_on == 1, "work submitted by a task of a did not run on a");
+}
+
+//==============================================================================
+// A thread attached to a static_thread_pool runs its work, and attach()
+// returns once the pool is closed and drained.
+
+void test_attach() {
+  static_thread_pool pool(1);
+  std::atomic<bool> attach_returned{false};
+  std::thread attached([&]{
+    pool.attach();
+    attach_returned = true;
+  });
+
+  std::atomic<bool> release_worker{false};
+  std::atomic<int> ran{0};
+  {
+    auto ex = pool.executor();
+    // occupy the only worker until a task run by the attached thread
+    // releases it
+    auto blocker = ex.twoway_execute([&]{
+      spin_until([&]{ return release_worker.load(); });
+    });
+    std::vector<future<void>> work;
+    for(int i = 0; i < 100; ++i) {
+      work.push_back(ex.twoway_execute([&]{ ++ran; }));
+    }
+    work.push_back(ex.twoway_execute([&]{ release_worker = true; }));
+    for(auto& f : work) f.get();
+    blocker.get();
+  }
+  check(ran == 100, "work submitted to the pool did not run");
+  check(not attach_returned, "attach() returned before the pool was closed");
+
+  // closes the pool and waits for the workers and the attached thread
+  pool.wait();
+  check(attach_returned, "attach() did not return after the pool was closed");
+  attached.join();
+}
+
+//==============================================================================
+// Threads of an idle pool stop spinning and park; the parked time is
+// recorded when a parked thread wakes up.
+
+void test_idle_stats() {
+  static_thread_pool pool(2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  auto idle = pool.idle_stats();
+  check(idle.parks > 0, "no thread parked on an idle pool");
+  check(idle.spinning.count() > 0, "no spinning time recorded");
+
+  // wake a parked thread
+  {
+    auto ex = pool.executor();
+    ex.twoway_execute([]{ }).get();
+  }
+  auto woken = pool.idle_stats();
+  check(woken.parked >= std::chrono::milliseconds(50), "parked time of an idle pool not recorded");
+  check(woken.parks >= idle.parks, "park count went down");
+  pool.wait();
+}
+
+//==============================================================================
+// main
+
+int main() {
+  start_watchdog(std::chrono::seconds(30));
+
+  test_try_executing_one_from_other_pool();
+  test_attach();
+  test_idle_stats();
+
+  std::printf("SUCCESS\n");
+  return 0;
+}
@@ -0,0 +1,164 @@
+
+#include <experimental/async_ptr>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::experimental;
+using namespace std;
+
+// Stress tests for the joins between borrows. Every borrow below has to wait
+// on a join of several futures that are not ready yet, and there are far
+// more such joins than there are threads to run borrows on. If a join ever
+// held a thread while waiting for one of its inputs (as `f1.then([f2]{
+// f2.wait(); })` does), the pool would run out of threads long before the
+// inputs could complete, and the test would time out.
+
+constexpr size_t num_ptrs = 256;
+constexpr size_t rounds = 8;
+constexpr auto time_limit = std::chrono::seconds(30);
+
+void fail(char const* what) {
+  std::fprintf(stderr, "FAILED: %s\n", what);
+  std::fflush(stderr);
+  std::abort();
+}
+
+void test_many_joins() {
+
+  std::vector<async_ptr<int>> ptrs;
+  ptrs.reserve(num_ptrs);
+  for(size_t i = 0; i < num_ptrs; ++i) {
+    ptrs.push_back(make_async_ptr<int>(0));
+  }
+
+  // Hold on to one writing borrow of every pointer, so that everything
+  // borrowed after it stays blocked until main() lets go of them
+  std::mutex held_mtx;
+  std::vector<async_ptr<int>> held;
+  for(auto& ptr : ptrs) {
+    ptr.borrow_async([&](auto borrowed) {
+      std::lock_guard<std::mutex> lg(held_mtx);
+      held.push_back(std::move(borrowed));
+    });
+  }
+  auto const start = std::chrono::steady_clock::now();
+  while(true) {
+    {
+      std::lock_guard<std::mutex> lg(held_mtx);
+      if(held.size() == num_ptrs) break;
+    }
+    if(std::chrono::steady_clock::now() - start > time_limit) fail("initial borrows never ran");
+    std::this_thread::yield();
+  }
+
+  // Queue up readers, writers and joint borrows of neighboring pointers.
+  // Readers of one round wait on the writer of the previous one, and each
+  // writer waits on all of the readers before it, so every borrow is behind
+  // a join of pending futures.
+  std::atomic<size_t> reads = { 0 };
+  std::atomic<size_t> joint = { 0 };
+  for(size_t round = 0; round < rounds; ++round) {
+    for(size_t i = 0; i < num_ptrs; ++i) {
+      for(int reader = 0; reader < 3; ++reader) {
+        ptrs[i].const_borrow_async([&](auto p) {
+          (void)p.get_const_value();
+          reads.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+      with_all_values(as_const(ptrs[i]), as_const(ptrs[(i + 1) % num_ptrs])).borrow_async(
+        [&](auto const&, auto const&) {
+          joint.fetch_add(1, std::memory_order_relaxed);
+        }
+      );
+      ptrs[i].borrow_value_async([](auto& value) { ++value; });
+    }
+  }
+
+  // Let go of the held borrows. The continuations that this completes run
+  // right here, so this must not block either
+  {
+    std::lock_guard<std::mutex> lg(held_mtx);
+    for(auto& ptr : held) ptr.set_value(1);
+    held.clear();
+  }
+
+  auto const expected_reads = num_ptrs * rounds * 3;
+  auto const expected_joint = num_ptrs * rounds;
+  while(reads.load() != expected_reads or joint.load() != expected_joint) {
+    if(std::chrono::steady_clock::now() - start > time_limit) fail("borrows did not complete");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  for(auto& ptr : ptrs) {
+    ptr.const_borrow_value_async([](int const& value) {
+      if(value != int(1 + rounds)) fail("wrong value after all borrows");
+    });
+  }
+  // destroying the pointers waits for the last borrows
+  ptrs.clear();
+
+  std::printf("%zu reads, %zu joint borrows\n", reads.load(), joint.load());
+}
+
+// A steady stream of short readers behind one long reader: every reader
+// joins the write future of the pointer with its own, and the whole chain
+// of joins completes when the long reader lets go. That must not take
+// stack space proportional to the number of readers.
+
+constexpr size_t num_readers = 200000;
+
+void test_long_reader_chain() {
+  auto const start = std::chrono::steady_clock::now();
+  std::atomic<size_t> reads = { 0 };
+  std::mutex held_mtx;
+  std::optional<const_async_ptr<int>> held;
+  std::atomic<bool> holding = { false };
+  {
+    auto ptr = make_async_ptr<int>(42);
+    ptr.const_borrow_async([&](auto borrowed) {
+      std::lock_guard<std::mutex> lg(held_mtx);
+      held.emplace(std::move(borrowed));
+      holding = true;
+    });
+    while(not holding.load()) {
+      if(std::chrono::steady_clock::now() - start > time_limit) fail("long reader never ran");
+      std::this_thread::yield();
+    }
+
+    for(size_t i = 0; i < num_readers; ++i) {
+      ptr.const_borrow_value_async([&](int const& value) {
+        if(value != 42) fail("wrong value in reader");
+        reads.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+    // readers don't wait for each other, or for the long one
+    while(reads.load() != num_readers) {
+      if(std::chrono::steady_clock::now() - start > time_limit) fail("readers did not run");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // completes every join queued behind the long reader, on this thread
+    {
+      std::lock_guard<std::mutex> lg(held_mtx);
+      held.reset();
+    }
+    // destroying ptr waits for all of them
+  }
+  std::printf("%zu readers behind one long reader\n", reads.load());
+}
+
+int main() {
+  test_many_joins();
+  test_long_reader_chain();
+
+  std::printf("SUCCESS\n");
+  return 0;
+}
@@ -13,7 +13,7 @@ namespace experimental {
 
 void detail::_async_ptr_control_base::_throw_if_cannot_read(const char* where) {
   if(not this->state_.can_read) {
-    read_promise_->set_exception(std::make_exception_ptr(
+    read_promise_.set_exception(std::make_exception_ptr(
       bad_access_of_borrowed_value(where)
     ));
     // For now:
@@ -24,7 +24,7 @@ void detail::_async_ptr_control_base::_throw_if_cannot_read(const char* where) {
 
 void detail::_async_ptr_control_base::_throw_if_cannot_write(const char* where) {
   if(not this->state_.can_write) {
-    write_promise_->set_exception(std::make_exception_ptr(
+    write_promise_.set_exception(std::make_exception_ptr(
       bad_access_of_borrowed_value(where)
     ));
     // For now:
@@ -33,32 +33,37 @@ void detail::_async_ptr_control_base::_throw_if_cannot_write(const char* where)
   }
 }
 
-std::shared_ptr<promise<void>>
+detail::_event_promise
 detail::_async_ptr_control_base::_make_chained_promise_ptr(
-  shared_ptr<promise<void>> chained_from
+  _event_promise chained_from
 ) {
   // make a write promise that also holds our write promise (and releases
-  // both our promise and theirs when it's destroyed)
-  return std::shared_ptr<promise<void>>(
-    new promise<void>(),
-      [chained_from](auto make_ready_then_delete) mutable {
-        try {
-          make_ready_then_delete->set_value();
-        }
-        catch (...) {
-          // An exception was already set on this; propagate it
-          // TODO figure out how to get the exception
-          chained_from->set_exception(std::make_exception_ptr(
-            bad_access_of_borrowed_value("unknown")
-          ));
-        }
-        // release our copy of chained_from from enclosing scope
-        chained_from = nullptr;
-        delete make_ready_then_delete;
-      }
-  );
+  // it once the new one completes; an exception set on the new one is
+  // propagated to chained_from first)
+  return _event_promise::make(std::move(chained_from));
 }
 
+namespace detail {
+
+// Runs the callable of a borrow that waited on waited_on. Pool tasks must
+// not throw, so an exception from the callable, or one that a borrow before
+// it left on waited_on, is set on the write promises of the borrowed
+// pointers instead. From there it is passed on to the pointers they were
+// borrowed from, whose release() rethrows it.
+template <typename F, typename... Promises>
+void _run_borrow_callable(_event_future const& waited_on, F&& f, Promises const&... promises) noexcept {
+  std::exception_ptr ex = waited_on.exception();
+  try {
+    std::forward<F>(f)();
+  }
+  catch(...) {
+    if(not ex) ex = std::current_exception();
+  }
+  if(ex) (promises.set_exception(ex), ...);
+}
+
+} // end namespace detail
+
 template <typename T>
 template <typename Callable, typename DerefBool, typename ConstBool>
 void
@@ -66,39 +71,52 @@ async_ptr<T>::_do_borrow_async(Callable&& callable, DerefBool, ConstBool) {
   // Do the borrow
   if constexpr (not ConstBool::value) {
     auto this_borrowed = _make_borrowed_ptr();
-    auto wait_on_future = make_ready_future().share();
-    auto wait_on_read_future = make_ready_future().share();
-    // Swap it with the write future so that it will be ready when the callable starts
-    std::swap(wait_on_future, this_borrowed.write_future_);
-    std::swap(wait_on_read_future, this_borrowed.read_future_);
+    // Take the futures out of the borrowed pointer (leaving it with ready
+    // ones) so that it will be usable when the callable starts
+    auto wait_on_future = std::exchange(this_borrowed.write_future_, {});
+    auto wait_on_read_future = std::exchange(this_borrowed.read_future_, {});
     // when everyone who says "can't read" and "can't write" is done, run the continuation
-    auto done_future = when_all(wait_on_future, wait_on_read_future).then([
-      callable=std::forward<Callable>(callable), this_borrowed=std::move(this_borrowed)
-    ](auto&&... /*ignored*/) mutable {
+    auto waited_on = detail::_when_all(wait_on_future, wait_on_read_future);
+    detail::_run_after(waited_on, [
+      callable=std::forward<Callable>(callable), this_borrowed=std::move(this_borrowed),
+      waited_on
+    ]() mutable {
       if constexpr(DerefBool::value) {
-        std::move(callable)(this_borrowed.get_value());
+        detail::_run_borrow_callable(waited_on, [&]{
+          std::move(callable)(this_borrowed.get_value());
+        }, this_borrowed.write_promise_);
       }
       else {
-        std::move(callable)(std::move(this_borrowed));
+        // the callable takes the borrowed pointer, keep its promise
+        auto promise = this_borrowed.write_promise_;
+        detail::_run_borrow_callable(waited_on, [&]{
+          std::move(callable)(std::move(this_borrowed));
+        }, promise);
       }
     });
   }
   else { // ConstBool::value == true
     // Do the borrow
     auto this_const_borrowed = _make_const_borrowed_ptr();
-    // make the new future to be swapped with the one we're supposed to wait on
-    auto wait_on_future = make_ready_future().share();
-    // Swap it with the write future so that it will be ready when the callable starts
-    std::swap(wait_on_future, this_const_borrowed.read_future_);
+    // Take the read future out of the borrowed pointer so that it will be
+    // usable when the callable starts
+    auto wait_on_future = std::exchange(this_const_borrowed.read_future_, {});
     // when everyone who says "can't read" is done, run the callable
-    auto done_future = wait_on_future.then([
-      callable=std::forward<Callable>(callable), this_const_borrowed=std::move(this_const_borrowed)
-    ](auto&&... /*ignored*/) mutable {
+    detail::_run_after(wait_on_future, [
+      callable=std::forward<Callable>(callable), this_const_borrowed=std::move(this_const_borrowed),
+      waited_on=wait_on_future
+    ]() mutable {
       if constexpr(DerefBool::value) {
-        std::move(callable)(this_const_borrowed.get_value());
+        detail::_run_borrow_callable(waited_on, [&]{
+          std::move(callable)(this_const_borrowed.get_const_value());
+        }, this_const_borrowed.write_promise_);
       }
       else {
-        std::move(callable)(std::move(this_const_borrowed));
+        // the callable takes the borrowed pointer, keep its promise
+        auto promise = this_const_borrowed.write_promise_;
+        detail::_run_borrow_callable(waited_on, [&]{
+          std::move(callable)(std::move(this_const_borrowed));
+        }, promise);
       }
     });
   }
@@ -144,7 +162,7 @@ template <typename Callable>
 void
 async_ptr<T>::const_borrow_value_async(Callable&& callable) {
   _do_borrow_async(std::forward<Callable>(callable),
-    /*deref=*/ std::false_type{}, /*const=*/ std::true_type{}
+    /*deref=*/ std::true_type{}, /*const=*/ std::true_type{}
   );
 }
 
@@ -152,8 +170,9 @@ template <typename T>
 async_ptr<T>::~async_ptr() {
   if(state_.wait_on_destruction) {
     // need to do waiting here so that destruction of T happens after waiting
-    if(read_future_.valid()) read_future_.get();
-    if(write_future_.valid()) write_future_.get();
+    // (an exception from a borrow is only rethrown by release())
+    read_future_.wait();
+    write_future_.wait();
   }
 }
 
@@ -171,19 +190,25 @@ void
 const_async_ptr<T>::_do_borrow_async(Callable&& callable, DerefBool) {
   // Do the borrow
   auto this_const_borrowed = _make_const_borrowed_ptr();
-  // make the new future to be swapped with the one we're supposed to wait on
-  auto wait_on_future = make_ready_future().share();
-  // Swap it with the write future so that it will be ready when the callable starts
-  std::swap(wait_on_future, this_const_borrowed.read_future_);
+  // Take the read future out of the borrowed pointer so that it will be
+  // usable when the callable starts
+  auto wait_on_future = std::exchange(this_const_borrowed.read_future_, {});
   // when everyone who says "can't read" is done, run the callable
-  auto done_future = wait_on_future.then([
-    callable=std::forward<Callable>(callable), this_borrowed=std::move(this_const_borrowed)
-  ](auto&&... /*ignored*/) mutable {
+  detail::_run_after(wait_on_future, [
+    callable=std::forward<Callable>(callable), this_const_borrowed=std::move(this_const_borrowed),
+    waited_on=wait_on_future
+  ]() mutable {
     if constexpr(DerefBool::value) {
-      std::move(callable)(this_const_borrowed.get_const_value());
+      detail::_run_borrow_callable(waited_on, [&]{
+        std::move(callable)(this_const_borrowed.get_const_value());
+      }, this_const_borrowed.write_promise_);
     }
     else {
-      std::move(callable)(std::move(this_const_borrowed));
+      // the callable takes the borrowed pointer, keep its promise
+      auto promise = this_const_borrowed.write_promise_;
+      detail::_run_borrow_callable(waited_on, [&]{
+        std::move(callable)(std::move(this_const_borrowed));
+      }, promise);
     }
   });
 }
@@ -214,8 +239,9 @@ template <typename T>
 const_async_ptr<T>::~const_async_ptr() {
   if(state_.wait_on_destruction) {
     // need to do waiting here so that destruction of T happens after waiting
-    if(read_future_.valid()) read_future_.get();
-    if(write_future_.valid()) write_future_.get();
+    // (an exception from a borrow is only rethrown by release())
+    read_future_.wait();
+    write_future_.wait();
   }
 }
 
@@ -229,36 +255,35 @@ detail::with_all_result_base<AsyncPtrTs...>::_do_borrow_async(
   auto do_borrow = [](auto& ptr) { return ptr._make_default_borrowed_ptr(); };
   auto these_borrowed = std::make_tuple(do_borrow(std::get<Idxs>(ptrs_))...);
 
-  // swap in ready futures and return the wait_on_futures
-  auto do_swap = [](auto& ptr_borrowed) {
-    auto wait_on_read_future = make_ready_future().share();
-    std::swap(wait_on_read_future, ptr_borrowed.read_future_);
-    auto wait_on_future = make_ready_future().share();
-    std::swap(wait_on_future, ptr_borrowed.write_future_);
-    return std::make_pair(wait_on_read_future, wait_on_future);
-  };
-  auto wait_on_future_pairs = std::make_tuple(do_swap(std::get<Idxs>(these_borrowed))...);
-  auto wait_on_futures = std::make_tuple(
-    std::move(std::get<0>(std::get<Idxs>(wait_on_future_pairs)))...,
-    std::move(std::get<1>(std::get<Idxs>(wait_on_future_pairs)))...
+  // take the futures out of the borrowed pointers (leaving them with ready
+  // ones) and join them into one
+  auto wait_on_future = _when_all(
+    std::exchange(std::get<Idxs>(these_borrowed).read_future_, {})...,
+    std::exchange(std::get<Idxs>(these_borrowed).write_future_, {})...
   );
 
   // when all of them have gotten write permissions, run the callable:
-  auto when_all_wrapped = [](auto&&... fs) { return when_all(std::move(fs)...); };
-  auto done_future = std::apply(when_all_wrapped, std::move(wait_on_futures)).then([
-    callable=std::forward<Callable>(callable), these_borrowed=std::move(these_borrowed)
-  ](auto&&... /*ignored*/) mutable {
+  _run_after(wait_on_future, [
+    callable=std::forward<Callable>(callable), these_borrowed=std::move(these_borrowed),
+    waited_on=wait_on_future
+  ]() mutable {
     if constexpr (DerefBool::value) {
-      // Deduction guide for tuple doesn't use decltype deduction, so we need
-      // to do it manually here:
-      using value_refs_tuple_t = tuple<decltype(std::get<Idxs>(these_borrowed)._get_value_with_minimum_constness())...>;
-      auto value_refs_tuple = value_refs_tuple_t(std::get<Idxs>(these_borrowed)._get_value_with_minimum_constness()...);
-      // No need to move; all entries in tuple should be references
-      static_assert(conjunction_v<is_lvalue_reference<tuple_element_t<Idxs, decay_t<decltype(value_refs_tuple)>>>...>);
-      std::apply(std::move(callable), value_refs_tuple);
+      _run_borrow_callable(waited_on, [&]{
+        // Deduction guide for tuple doesn't use decltype deduction, so we need
+        // to do it manually here:
+        using value_refs_tuple_t = tuple<decltype(std::get<Idxs>(these_borrowed)._get_value_with_minimum_constness())...>;
+        auto value_refs_tuple = value_refs_tuple_t(std::get<Idxs>(these_borrowed)._get_value_with_minimum_constness()...);
+        // No need to move; all entries in tuple should be references
+        static_assert(conjunction_v<is_lvalue_reference<tuple_element_t<Idxs, decay_t<decltype(value_refs_tuple)>>>...>);
+        std::apply(std::move(callable), value_refs_tuple);
+      }, std::get<Idxs>(these_borrowed).write_promise_...);
     }
     else {
-      std::apply(std::move(callable), std::move(these_borrowed));
+      // the callable takes the borrowed pointers, keep their promises
+      auto promises = std::make_tuple(std::get<Idxs>(these_borrowed).write_promise_...);
+      _run_borrow_callable(waited_on, [&]{
+        std::apply(std::move(callable), std::move(these_borrowed));
+      }, std::get<Idxs>(promises)...);
     }
   });
 }
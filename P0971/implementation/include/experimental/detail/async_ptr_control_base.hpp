@@ -1,10 +1,12 @@
 #ifndef ASYNC_PTR_EXPERIMENTAL_DETAIL_ASYNC_PTR_BASE_HPP
 #define ASYNC_PTR_EXPERIMENTAL_DETAIL_ASYNC_PTR_BASE_HPP
 
+#include <experimental/detail/completion_event.hpp>
 #include <experimental/future>
 #include <experimental/type_traits>
 
 #include <memory>
+#include <utility>
 
 namespace std {
 namespace experimental {
@@ -35,10 +37,12 @@ struct as_const_wrapper;
 struct _async_ptr_control_base {
   public:
 
-    shared_ptr<promise<void>> write_promise_;
-    shared_future<void> write_future_;
-    shared_ptr<promise<void>> read_promise_;
-    shared_future<void> read_future_;
+    // Null promises hold no obligation and null futures are ready, see
+    // completion_event.hpp
+    _event_promise write_promise_;
+    _event_future write_future_;
+    _event_promise read_promise_;
+    _event_future read_future_;
 
     // TODO handle case of move after destruction of context???
     // EXPERIMENTAL
@@ -51,19 +55,10 @@ struct _async_ptr_control_base {
       bool wait_on_destruction /*: 1*/ = true;
     } state_ = { };
 
-    _async_ptr_control_base()
-      : write_future_(std::experimental::make_ready_future().share()),
-        write_promise_(nullptr),
-        read_promise_(nullptr),
-        read_future_(std::experimental::make_ready_future().share())
-    { }
+    _async_ptr_control_base() = default;
 
     _async_ptr_control_base(std::nullptr_t) noexcept
-      : write_future_(),
-        write_promise_(nullptr),
-        read_future_(),
-        read_promise_(nullptr),
-        state_{false, false, false}
+      : state_{false, false, false}
     { }
 
     _async_ptr_control_base(_async_ptr_control_base&& other) = default;
@@ -84,8 +79,8 @@ struct _async_ptr_control_base {
     //  }
     //}
 
-    shared_ptr<promise<void>>
-    _make_chained_promise_ptr(shared_ptr<promise<void>> chained_from);
+    _event_promise
+    _make_chained_promise_ptr(_event_promise chained_from);
 
     void _throw_if_cannot_read(const char*);
 
@@ -97,17 +92,17 @@ struct _async_ptr_control_base {
       state_.can_read = false;
       state_.can_write = false;
       if(state_.wait_on_destruction) {
-        read_future_.get();
-        write_future_.get();
+        // rethrows an exception from a borrow; the futures are taken out
+        // first so that the destructor doesn't wait on them again
+        state_.wait_on_destruction = false;
+        auto read_future = std::exchange(read_future_, {});
+        auto write_future = std::exchange(write_future_, {});
+        read_future.wait();
+        write_future.get();
+        read_future.get();
       }
     }
 
-    auto _make_chained_future(shared_future<void> const& f1, shared_future<void> const& f2) {
-      // not very efficient, but we'll have better ways to do this in the future
-      // I guess...
-      return f1.then([f2](auto&&... /*ignored*/){ f2.wait(); });
-    }
-
     auto _do_const_borrow(_async_ptr_control_base& rv) {
       // If this holds a write promise to borrowed-from pointer in its outer
       // scope, the borrowed pointer also needs to hold that promise
@@ -122,7 +117,7 @@ struct _async_ptr_control_base {
       // Pointers borrowed from the continuation should not do any writes until
       // the promise from the reading borrower is fullfilled.
       // Anything after us should also wait on anything that says rv can't write
-      write_future_ = _make_chained_future(write_future_, rv.write_promise_->get_future().share());
+      write_future_ = _when_all(write_future_, rv.write_promise_.get_future());
       // `this` still holds the ability to create write tasks, so
       // this.write_promise_ is unchanged.
       // a const pointer only says "can't write" to pointers borrowed from the
@@ -0,0 +1,200 @@
+#ifndef ASYNC_PTR_EXPERIMENTAL_DETAIL_BLOCK_POOL_HPP
+#define ASYNC_PTR_EXPERIMENTAL_DETAIL_BLOCK_POOL_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace std {
+namespace experimental {
+inline namespace executors_v1 {
+namespace detail {
+
+//==============================================================================
+// fixed size block pools
+//
+// Pool tasks, completion events and their continuations are allocated and
+// freed at the rate of several per async_ptr borrow, so they come from
+// per-thread free lists of fixed size blocks instead of the general purpose
+// allocator. These blocks typically flow one way, allocated by the thread
+// that borrows and freed by the pool thread that runs the borrow, so a
+// thread whose list grows past two batches hands a batch of batch_size
+// blocks to a shared depot, and a thread whose list is empty takes a batch
+// from there before falling back to operator new. The depot lock is taken
+// once per batch_size blocks.
+
+template <std::size_t BlockSize>
+class _fixed_block_pool {
+  private:
+
+    struct _block { _block* next_; };
+
+    struct _batch {
+      _block* head_;
+      std::size_t count_;
+    };
+
+    static constexpr std::size_t batch_size = 64;
+
+    // Never destroyed: thread_local caches of threads that outlive static
+    // destruction (e.g., the workers of a static pool) still return to it
+    struct _depot {
+      std::mutex mtx_;
+      std::vector<_batch> batches_;
+    };
+
+    static _depot& _global() {
+      static _depot* depot = new _depot();
+      return *depot;
+    }
+
+    static void _give(_batch b) {
+      if(not b.head_) return;
+      auto& d = _global();
+      std::lock_guard<std::mutex> lg(d.mtx_);
+      d.batches_.push_back(b);
+    }
+
+    static _batch _take() {
+      auto& d = _global();
+      std::lock_guard<std::mutex> lg(d.mtx_);
+      if(d.batches_.empty()) return { nullptr, 0 };
+      _batch b = d.batches_.back();
+      d.batches_.pop_back();
+      return b;
+    }
+
+    struct _cache {
+      _block* head_ = nullptr;
+      std::size_t count_ = 0;
+
+      _batch split_batch() noexcept {
+        _batch b = { head_, batch_size };
+        _block* last = head_;
+        for(std::size_t i = 1; i < batch_size; ++i) last = last->next_;
+        head_ = last->next_;
+        last->next_ = nullptr;
+        count_ -= batch_size;
+        return b;
+      }
+
+      ~_cache() {
+        _destroyed() = true;
+        try {
+          _give({ head_, count_ });
+        }
+        catch(...) {
+          while(head_) {
+            _block* next = head_->next_;
+            ::operator delete(head_);
+            head_ = next;
+          }
+        }
+      }
+    };
+
+    static _cache& _local() noexcept {
+      thread_local _cache cache;
+      return cache;
+    }
+
+    // trivially destructible, so still usable by thread_local destructors
+    // that run after the cache's
+    static bool& _destroyed() noexcept {
+      thread_local bool destroyed = false;
+      return destroyed;
+    }
+
+  public:
+
+    static constexpr std::size_t block_size = BlockSize;
+
+    static void* allocate() {
+      if(not _destroyed()) {
+        _cache& c = _local();
+        if(not c.head_) {
+          _batch b = _take();
+          c.head_ = b.head_;
+          c.count_ = b.count_;
+        }
+        if(_block* b = c.head_) {
+          c.head_ = b->next_;
+          --c.count_;
+          return b;
+        }
+      }
+      return ::operator new(BlockSize);
+    }
+
+    static void deallocate(void* p) noexcept {
+      if(_destroyed()) {
+        ::operator delete(p);
+        return;
+      }
+      _cache& c = _local();
+      auto* b = static_cast<_block*>(p);
+      b->next_ = c.head_;
+      c.head_ = b;
+      ++c.count_;
+      if(c.count_ >= 2 * batch_size) {
+        _batch batch = c.split_batch();
+        try {
+          _give(batch);
+        }
+        catch(...) {
+          // depot can't grow; give the memory back instead
+          while(batch.head_) {
+            _block* next = batch.head_->next_;
+            ::operator delete(batch.head_);
+            batch.head_ = next;
+          }
+        }
+      }
+    }
+};
+
+template <std::size_t Size>
+using _block_pool_for_t = std::conditional_t<(Size <= 64), _fixed_block_pool<64>,
+  std::conditional_t<(Size <= 128), _fixed_block_pool<128>,
+  std::conditional_t<(Size <= 256), _fixed_block_pool<256>, void>>>;
+
+template <typename T, typename... Args>
+T* _pool_new(Args&&... args) {
+  static_assert(alignof(T) <= alignof(std::max_align_t));
+  using pool_t = _block_pool_for_t<sizeof(T)>;
+  if constexpr (std::is_void_v<pool_t>) {
+    return new T(std::forward<Args>(args)...);
+  }
+  else {
+    void* p = pool_t::allocate();
+    try {
+      return ::new(p) T(std::forward<Args>(args)...);
+    }
+    catch(...) {
+      pool_t::deallocate(p);
+      throw;
+    }
+  }
+}
+
+template <typename T>
+void _pool_delete(T* p) noexcept {
+  using pool_t = _block_pool_for_t<sizeof(T)>;
+  if constexpr (std::is_void_v<pool_t>) {
+    delete p;
+  }
+  else {
+    p->~T();
+    pool_t::deallocate(p);
+  }
+}
+
+} // namespace detail
+} // inline namespace executors_v1
+} // namespace experimental
+} // namespace std
+
+#endif // ASYNC_PTR_EXPERIMENTAL_DETAIL_BLOCK_POOL_HPP
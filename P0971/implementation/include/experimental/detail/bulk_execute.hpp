@@ -0,0 +1,203 @@
+#ifndef ASYNC_PTR_EXPERIMENTAL_DETAIL_BULK_EXECUTE_HPP
+#define ASYNC_PTR_EXPERIMENTAL_DETAIL_BULK_EXECUTE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+inline namespace executors_v1 {
+namespace detail {
+
+enum class _bulk_partition { static_chunks, dynamic_chunks, guided_chunks };
+
+//==============================================================================
+// one fork-join over the index space [0, n)
+//
+// The calling thread is one of the participants: it submits one helper task
+// per additional pool thread (never more than there are chunks), works on
+// the index space itself, and then joins by counting down the helpers that
+// are still running, executing other pool work while it waits so that a
+// bulk_execute from inside a pool task cannot starve its own helpers.
+//
+// Participants claim work from a shared counter, so a helper that only
+// starts after the others have finished everything exits immediately:
+//   - static: the counter hands out participant ids; participant k runs
+//     chunks k, k + p, k + 2p, ...
+//   - dynamic: the counter hands out chunks of a fixed size
+//   - guided: the counter hands out chunks of remaining / (2p) indices,
+//     but at least chunk_size
+//
+// body(first, last) runs a contiguous range of indices. The first exception
+// thrown by body is rethrown to the caller once every participant is done.
+
+template <typename Body>
+struct _bulk_fork_join_state {
+  Body& body_;
+  std::size_t n_;
+  std::size_t participants_;
+  std::size_t chunk_;
+  _bulk_partition partition_;
+
+  alignas(64) std::atomic<std::size_t> next_ = { 0 };
+  alignas(64) std::atomic<std::size_t> running_helpers_ = { 0 };
+  std::atomic<bool> failed_ = { false };
+  std::exception_ptr exception_;
+
+  _bulk_fork_join_state(Body& body, std::size_t n, std::size_t participants,
+    std::size_t chunk, _bulk_partition partition
+  ) : body_(body), n_(n), participants_(participants), chunk_(chunk),
+      partition_(partition)
+  { }
+
+  void _run_range(std::size_t first, std::size_t last) {
+    if(failed_.load(std::memory_order_relaxed)) return;
+    try {
+      body_(first, last);
+    }
+    catch(...) {
+      if(not failed_.exchange(true, std::memory_order_acq_rel)) {
+        exception_ = std::current_exception();
+      }
+    }
+  }
+
+  void participate() {
+    switch(partition_) {
+      case _bulk_partition::static_chunks: {
+        std::size_t id;
+        while((id = next_.fetch_add(1, std::memory_order_relaxed)) < participants_) {
+          for(std::size_t first = id * chunk_; first < n_; first += participants_ * chunk_) {
+            _run_range(first, std::min(n_, first + chunk_));
+          }
+        }
+        break;
+      }
+      case _bulk_partition::dynamic_chunks: {
+        std::size_t first;
+        while((first = next_.fetch_add(chunk_, std::memory_order_relaxed)) < n_) {
+          _run_range(first, std::min(n_, first + chunk_));
+        }
+        break;
+      }
+      case _bulk_partition::guided_chunks: {
+        std::size_t first = next_.load(std::memory_order_relaxed);
+        while(first < n_) {
+          std::size_t const size = std::max(chunk_, (n_ - first) / (2 * participants_));
+          std::size_t const last = std::min(n_, first + size);
+          if(next_.compare_exchange_weak(first, last, std::memory_order_relaxed)) {
+            _run_range(first, last);
+            first = next_.load(std::memory_order_relaxed);
+          }
+        }
+        break;
+      }
+    }
+  }
+};
+
+template <typename Pool, typename Body>
+void _bulk_fork_join(Pool& pool, std::size_t n, _bulk_partition partition,
+  std::size_t chunk_size, Body&& body
+) {
+  if(n == 0) return;
+  std::size_t const threads = pool.num_threads() + 1;
+
+  std::size_t chunk = chunk_size;
+  if(chunk == 0) {
+    switch(partition) {
+      case _bulk_partition::static_chunks: chunk = (n + threads - 1) / threads; break;
+      case _bulk_partition::dynamic_chunks: chunk = std::max<std::size_t>(1, n / (8 * threads)); break;
+      case _bulk_partition::guided_chunks: chunk = 1; break;
+    }
+  }
+  std::size_t const chunks = (n + chunk - 1) / chunk;
+  std::size_t const participants = std::min(threads, chunks);
+
+  _bulk_fork_join_state<std::remove_reference_t<Body>> state(
+    body, n, participants, chunk, partition
+  );
+
+  for(std::size_t i = 1; i < participants; ++i) {
+    state.running_helpers_.fetch_add(1, std::memory_order_relaxed);
+    try {
+      pool.submit([&state]{
+        state.participate();
+        // last access to state, which lives on the caller's stack
+        state.running_helpers_.fetch_sub(1, std::memory_order_release);
+      });
+    }
+    catch(...) {
+      // the participants already running (at least the caller) pick up
+      // the work of the helpers that could not be submitted
+      state.running_helpers_.fetch_sub(1, std::memory_order_relaxed);
+      break;
+    }
+  }
+
+  state.participate();
+
+  while(state.running_helpers_.load(std::memory_order_acquire) != 0) {
+    if(not pool.try_executing_one()) std::this_thread::yield();
+  }
+
+  if(state.exception_) std::rethrow_exception(state.exception_);
+}
+
+//==============================================================================
+// N-dimensional shapes
+//
+// A shape with a static rank() and extent(r), such as
+// std::experimental::extents, is run as a row-major linearization of its
+// index space; every range of linear indices is turned back into
+// multi-indices once, and then advanced like an odometer.
+
+template <std::size_t Rank, typename Shape, typename Function, std::size_t... R>
+void _bulk_invoke_nd(Function& f, std::array<std::size_t, Rank> const& idx,
+  std::index_sequence<R...>
+) {
+  f(idx[R]...);
+}
+
+template <typename Shape, typename Function>
+auto _bulk_nd_body(Shape const& shape, Function& f) {
+  constexpr std::size_t rank = Shape::rank();
+  std::array<std::size_t, rank> extents = { };
+  for(std::size_t r = 0; r < rank; ++r) extents[r] = std::size_t(shape.extent(r));
+
+  return [extents, &f](std::size_t first, std::size_t last) {
+    std::array<std::size_t, rank> idx = { };
+    std::size_t linear = first;
+    for(std::size_t r = rank; r-- > 0; ) {
+      idx[r] = linear % extents[r];
+      linear /= extents[r];
+    }
+    for(std::size_t i = first; i < last; ++i) {
+      _bulk_invoke_nd<rank, Shape>(f, idx, std::make_index_sequence<rank>{});
+      for(std::size_t r = rank; r-- > 0; ) {
+        if(++idx[r] < extents[r]) break;
+        idx[r] = 0;
+      }
+    }
+  };
+}
+
+template <typename Shape>
+std::size_t _bulk_nd_size(Shape const& shape) {
+  std::size_t n = 1;
+  for(std::size_t r = 0; r < Shape::rank(); ++r) n *= std::size_t(shape.extent(r));
+  return n;
+}
+
+} // namespace detail
+} // inline namespace executors_v1
+} // namespace experimental
+} // namespace std
+
+#endif // ASYNC_PTR_EXPERIMENTAL_DETAIL_BULK_EXECUTE_HPP
@@ -0,0 +1,445 @@
+#ifndef ASYNC_PTR_EXPERIMENTAL_DETAIL_COMPLETION_EVENT_HPP
+#define ASYNC_PTR_EXPERIMENTAL_DETAIL_COMPLETION_EVENT_HPP
+
+// Must come before the first `namespace detail` in std::experimental, so that
+// std::experimental::detail and std::experimental::executors_v1::detail are
+// the same namespace rather than two ambiguous ones
+#include <experimental/detail/block_pool.hpp>
+#include <experimental/detail/work_stealing_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+namespace detail {
+
+//==============================================================================
+// default executor for borrow continuations
+
+inline _work_stealing_pool& _async_ptr_default_pool() {
+  static _work_stealing_pool pool(
+    std::max<std::size_t>(1, std::thread::hardware_concurrency())
+  );
+  return pool;
+}
+
+//==============================================================================
+// _completion_event
+//
+// A one-shot event replacing promise<void>/shared_future<void> in the
+// async_ptr internals. It is intrusively reference counted and keeps two
+// counts:
+//   - refs_: every handle (_event_future or _event_promise) to the event,
+//     the event is freed when it drops to zero
+//   - producers_: _event_promise handles only; like the deleter of the
+//     shared_ptr<promise<void>> it replaces, the event completes when the
+//     last of them is released
+// An event can be chained from a producer handle of another event, which it
+// releases right after it completes itself (_make_chained_promise_ptr).
+//
+// Continuations are kept in a lock-free stack and run, in the order they
+// were added, by the thread that completes the event, or immediately by the
+// thread adding them if the event is already complete. They must therefore
+// be short; anything else is submitted to a pool by the continuation.
+//
+// Completing one event often completes others: continuations release
+// producers of joined events (_when_all) and chained events release their
+// parent. Those completions are queued on a per-thread worklist and run by
+// the outermost completion on the thread rather than recursively, so a
+// chain of any length (e.g., one join per reader queued behind a long
+// writer) completes in constant stack depth.
+
+struct _event_continuation {
+  _event_continuation* next_ = nullptr;
+  // runs the continuation and frees it
+  virtual void _run() noexcept = 0;
+  virtual ~_event_continuation() = default;
+};
+
+template <typename F>
+struct _event_continuation_impl final : _event_continuation {
+  F f_;
+
+  template <typename G>
+  explicit _event_continuation_impl(G&& g) : f_(std::forward<G>(g)) { }
+
+  void _run() noexcept override {
+    std::move(f_)();
+    _pool_delete(this);
+  }
+};
+
+class _completion_event {
+  private:
+
+    std::atomic<std::uint32_t> refs_ = { 0 };
+    std::atomic<std::uint32_t> producers_ = { 0 };
+    std::atomic<_event_continuation*> continuations_ = { nullptr };
+    std::atomic<bool> has_exception_ = { false };
+    std::exception_ptr exception_;
+    _completion_event* chained_from_ = nullptr; // holds a producer reference
+    _completion_event* next_completed_ = nullptr; // in the worklist below
+
+    // completed events that still need their _complete() run; each holds
+    // the reference of the producer that completed it
+    struct _worklist {
+      _completion_event* head_ = nullptr;
+      bool draining_ = false;
+    };
+
+    static _worklist& _this_thread_worklist() noexcept {
+      thread_local _worklist w;
+      return w;
+    }
+
+    static _event_continuation* _complete_marker() noexcept {
+      return reinterpret_cast<_event_continuation*>(std::uintptr_t(1));
+    }
+
+    void _complete() noexcept {
+      _event_continuation* head = continuations_.exchange(
+        _complete_marker(), std::memory_order_acq_rel
+      );
+      // continuations were pushed onto a stack; run them oldest first
+      _event_continuation* fifo = nullptr;
+      while(head) {
+        _event_continuation* next = head->next_;
+        head->next_ = fifo;
+        fifo = head;
+        head = next;
+      }
+      while(fifo) {
+        _event_continuation* next = fifo->next_;
+        fifo->_run();
+        fifo = next;
+      }
+      if(_completion_event* parent = std::exchange(chained_from_, nullptr)) {
+        if(has_exception_.load(std::memory_order_acquire)) {
+          parent->set_exception(exception_);
+        }
+        parent->release_producer();
+      }
+    }
+
+    struct _waiter final : _event_continuation {
+      std::mutex mtx_;
+      std::condition_variable cv_;
+      bool done_ = false;
+
+      void _run() noexcept override {
+        // notify while holding the lock: the waiter (and this object, which
+        // lives on its stack) can't go away before the lock is released
+        std::lock_guard<std::mutex> lg(mtx_);
+        done_ = true;
+        cv_.notify_one();
+      }
+    };
+
+  public:
+
+    _completion_event() = default;
+    _completion_event(const _completion_event&) = delete;
+    _completion_event& operator=(const _completion_event&) = delete;
+
+    static _completion_event* create(_completion_event* chained_from = nullptr) {
+      auto* e = _pool_new<_completion_event>();
+      e->chained_from_ = chained_from;
+      return e;
+    }
+
+    void add_ref() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() noexcept {
+      if(refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _pool_delete(this);
+      }
+    }
+
+    void add_producer() noexcept { producers_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release_producer() noexcept {
+      if(producers_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        release();
+        return;
+      }
+      auto& w = _this_thread_worklist();
+      next_completed_ = w.head_;
+      w.head_ = this;
+      // an enclosing release_producer() on this thread drains it
+      if(w.draining_) return;
+      w.draining_ = true;
+      while(_completion_event* e = w.head_) {
+        w.head_ = e->next_completed_;
+        e->_complete();
+        e->release();
+      }
+      w.draining_ = false;
+    }
+
+    bool is_ready() const noexcept {
+      return continuations_.load(std::memory_order_acquire) == _complete_marker();
+    }
+
+    // The first exception set is kept and rethrown by get(); the event
+    // still only completes once all of its producers are released.
+    void set_exception(std::exception_ptr e) noexcept {
+      if(not has_exception_.exchange(true, std::memory_order_acq_rel)) {
+        exception_ = std::move(e);
+      }
+    }
+
+    // takes ownership of c
+    void add_continuation(_event_continuation* c) noexcept {
+      _event_continuation* head = continuations_.load(std::memory_order_acquire);
+      do {
+        if(head == _complete_marker()) {
+          c->_run();
+          return;
+        }
+        c->next_ = head;
+      } while(not continuations_.compare_exchange_weak(head, c,
+        std::memory_order_acq_rel, std::memory_order_acquire
+      ));
+    }
+
+    template <typename F>
+    void then(F&& f) {
+      if(is_ready()) {
+        std::forward<F>(f)();
+        return;
+      }
+      add_continuation(_pool_new<_event_continuation_impl<std::decay_t<F>>>(
+        std::forward<F>(f)
+      ));
+    }
+
+    // A thread of the default pool keeps running other borrow continuations
+    // while it waits, since the work it waits for may be queued behind it.
+    void wait() {
+      if(is_ready()) return;
+      auto& pool = _async_ptr_default_pool();
+      if(pool.running_in_this_thread()) {
+        while(not is_ready()) {
+          if(not pool.try_executing_one()) std::this_thread::yield();
+        }
+        return;
+      }
+      _waiter w;
+      add_continuation(&w);
+      std::unique_lock<std::mutex> lk(w.mtx_);
+      w.cv_.wait(lk, [&w]{ return w.done_; });
+    }
+
+    void get() {
+      wait();
+      if(has_exception_.load(std::memory_order_acquire)) {
+        std::rethrow_exception(exception_);
+      }
+    }
+
+    // only meaningful once the event is ready
+    std::exception_ptr exception() const noexcept {
+      if(has_exception_.load(std::memory_order_acquire)) return exception_;
+      return nullptr;
+    }
+};
+
+//==============================================================================
+// handles
+
+class _event_future;
+
+template <typename... Futures>
+_event_future _when_all(Futures const&... fs);
+
+// Consumer handle, replaces shared_future<void>. A null handle is an event
+// that is already complete, so ready "futures" cost nothing.
+class _event_future {
+  private:
+
+    _completion_event* event_ = nullptr;
+
+  public:
+
+    _event_future() noexcept = default;
+
+    // adopts a reference
+    explicit _event_future(_completion_event* e) noexcept : event_(e) { }
+
+    _event_future(_event_future const& other) noexcept : event_(other.event_) {
+      if(event_) event_->add_ref();
+    }
+
+    _event_future(_event_future&& other) noexcept
+      : event_(std::exchange(other.event_, nullptr))
+    { }
+
+    _event_future& operator=(_event_future other) noexcept {
+      std::swap(event_, other.event_);
+      return *this;
+    }
+
+    ~_event_future() { if(event_) event_->release(); }
+
+    explicit operator bool() const noexcept { return event_ != nullptr; }
+
+    bool is_ready() const noexcept { return not event_ or event_->is_ready(); }
+
+    void wait() const { if(event_) event_->wait(); }
+
+    void get() const { if(event_) event_->get(); }
+
+    // only meaningful once the future is ready
+    std::exception_ptr exception() const noexcept {
+      return event_ ? event_->exception() : nullptr;
+    }
+
+    // Runs f() inline once the event completes (see _completion_event)
+    template <typename F>
+    void then(F&& f) const {
+      if(event_) event_->then(std::forward<F>(f));
+      else std::forward<F>(f)();
+    }
+
+    template <typename... Futures>
+    friend _event_future _when_all(Futures const&... fs);
+};
+
+// Producer handle, replaces shared_ptr<promise<void>>: copies share the
+// obligation, and the event completes when the last copy is released.
+class _event_promise {
+  private:
+
+    _completion_event* event_ = nullptr;
+
+    explicit _event_promise(_completion_event* e) noexcept : event_(e) {
+      event_->add_ref();
+      event_->add_producer();
+    }
+
+  public:
+
+    _event_promise() noexcept = default;
+    _event_promise(std::nullptr_t) noexcept { }
+
+    // a new event; if chained_from is non-null, the new event keeps the
+    // obligation of chained_from until it completes itself
+    static _event_promise make(_event_promise chained_from = nullptr) {
+      return _event_promise(
+        _completion_event::create(std::exchange(chained_from.event_, nullptr))
+      );
+    }
+
+    _event_promise(_event_promise const& other) noexcept : event_(other.event_) {
+      if(event_) {
+        event_->add_ref();
+        event_->add_producer();
+      }
+    }
+
+    _event_promise(_event_promise&& other) noexcept
+      : event_(std::exchange(other.event_, nullptr))
+    { }
+
+    _event_promise& operator=(_event_promise other) noexcept {
+      std::swap(event_, other.event_);
+      return *this;
+    }
+
+    ~_event_promise() { if(event_) event_->release_producer(); }
+
+    explicit operator bool() const noexcept { return event_ != nullptr; }
+
+    _event_future get_future() const noexcept {
+      if(not event_) return _event_future();
+      event_->add_ref();
+      return _event_future(event_);
+    }
+
+    void set_exception(std::exception_ptr e) const noexcept {
+      if(event_) event_->set_exception(std::move(e));
+    }
+};
+
+//==============================================================================
+// _when_all
+//
+// A future that completes once all of fs have, with the first exception
+// among them. Nothing waits: every input that is still pending holds one
+// producer reference to the joined event, which it releases from a
+// continuation when it completes, so the producer count of the joined event
+// is the countdown, and whichever input completes last completes the join.
+// Joins where at most one input is still pending (the common case) return
+// that input rather than allocating a new event.
+
+template <typename... Futures>
+_event_future _when_all(Futures const&... fs) {
+  static_assert(std::conjunction_v<std::is_same<Futures, _event_future>...>,
+    "_when_all() joins _event_futures"
+  );
+  _completion_event* events[] = { fs.event_..., nullptr };
+
+  std::size_t n_pending = 0;
+  _completion_event* last_pending = nullptr;
+  for(std::size_t i = 0; i < sizeof...(fs); ++i) {
+    _completion_event* e = events[i];
+    // a ready input without an exception contributes nothing
+    if(not e or (e->is_ready() and not e->exception())) continue;
+    ++n_pending;
+    last_pending = e;
+  }
+  if(n_pending == 0) return _event_future();
+  if(n_pending == 1) {
+    last_pending->add_ref();
+    return _event_future(last_pending);
+  }
+
+  _completion_event* joined = _completion_event::create();
+  // hold a producer reference while joining, so that inputs completing
+  // concurrently can't complete the join before all of them are counted
+  joined->add_ref();
+  joined->add_producer();
+  for(std::size_t i = 0; i < sizeof...(fs); ++i) {
+    _completion_event* e = events[i];
+    if(not e) continue;
+    joined->add_ref();
+    joined->add_producer();
+    // e is kept alive while its continuations run, either by the handle
+    // that completes it or by its handle in fs if it is already complete
+    e->then([e, joined]{
+      if(auto ex = e->exception()) joined->set_exception(std::move(ex));
+      joined->release_producer();
+    });
+  }
+  joined->add_ref();
+  _event_future rv(joined);
+  joined->release_producer();
+  return rv;
+}
+
+// Submits task to the default pool once f is ready
+template <typename F>
+void _run_after(_event_future const& f, F&& task) {
+  if(f.is_ready()) {
+    _async_ptr_default_pool().submit(std::forward<F>(task));
+    return;
+  }
+  f.then([task=std::forward<F>(task)]() mutable {
+    _async_ptr_default_pool().submit(std::move(task));
+  });
+}
+
+} // end namespace detail
+} // end namespace experimental
+} // end namespace std
+
+#endif // ASYNC_PTR_EXPERIMENTAL_DETAIL_COMPLETION_EVENT_HPP
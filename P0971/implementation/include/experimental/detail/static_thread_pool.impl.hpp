@@ -15,6 +15,7 @@
 
 #include <boost/thread/executor.hpp>
 #include "static_thread_pool_fwd.hpp"
+#include "bulk_execute.hpp"
 
 namespace std {
 namespace experimental {
@@ -25,6 +26,16 @@ class _static_thread_pool_executor {
   private:
     static_thread_pool* context_;
     std::shared_ptr<promise<void>> executors_done_promise_;
+    _bulk_partition bulk_partition_ = _bulk_partition::static_chunks;
+    std::size_t bulk_chunk_size_ = 0;
+
+    _static_thread_pool_executor
+    _with_bulk_partition(_bulk_partition partition, std::size_t chunk_size) const {
+      auto rv = *this;
+      rv.bulk_partition_ = partition;
+      rv.bulk_chunk_size_ = chunk_size;
+      return rv;
+    }
 
     explicit
     _static_thread_pool_executor(static_thread_pool* context)
@@ -65,6 +76,41 @@ class _static_thread_pool_executor {
       }
     };
 
+    // Calls f(i, s) for every i in [0, shape), where s is the result of
+    // shared_factory(), and returns once all of them have completed. The
+    // shape is split into chunks according to the bulk_static (default),
+    // bulk_dynamic or bulk_guided property; the calling thread works on
+    // chunks too, and the whole call is a single fork-join on the pool.
+    template<class Function, class SharedFactory>
+    void bulk_execute(Function&& f, std::size_t shape, SharedFactory&& shared_factory) const {
+      auto* pool = context_->_get_valid_impl_ptr();
+      if(not pool) {
+        throw std::runtime_error("bulk_execute on stopped pool!");
+      }
+      auto shared = std::forward<SharedFactory>(shared_factory)();
+      auto body = [&f, &shared](std::size_t first, std::size_t last) {
+        for(std::size_t i = first; i < last; ++i) f(i, shared);
+      };
+      _bulk_fork_join(*pool, shape, bulk_partition_, bulk_chunk_size_, body);
+    }
+
+    // N-dimensional shape, e.g. an extents object: calls f(i0, ..., iN, s)
+    // for every multi-index of shape, the last index varying fastest.
+    template<class Function, class Shape, class SharedFactory,
+      class = decltype(Shape::rank(), std::declval<Shape const&>().extent(0))
+    >
+    void bulk_execute(Function&& f, Shape const& shape, SharedFactory&& shared_factory) const {
+      auto* pool = context_->_get_valid_impl_ptr();
+      if(not pool) {
+        throw std::runtime_error("bulk_execute on stopped pool!");
+      }
+      auto shared = std::forward<SharedFactory>(shared_factory)();
+      auto g = [&f, &shared](auto... indices) { f(indices..., shared); };
+      _bulk_fork_join(*pool, _bulk_nd_size(shape), bulk_partition_, bulk_chunk_size_,
+        _bulk_nd_body(shape, g)
+      );
+    }
+
     auto require(execution::oneway_t) { return *this; }
     auto require(execution::twoway_t) { return *this; }
     auto require(execution::then_t) { return *this; }
@@ -73,8 +119,17 @@ class _static_thread_pool_executor {
     auto require(execution::not_continuation_t) { return *this; }
     auto require(execution::not_outstanding_work_t) { return *this; }
 
-    // TODO bulk operations?
-    // auto require(execution::bulk_t) { return *this; }
+    auto require(execution::bulk_t) { return *this; }
+    auto require(execution::bulk_parallel_execution_t) { return *this; }
+    auto require(execution::bulk_static_t p) const {
+      return _with_bulk_partition(_bulk_partition::static_chunks, p.chunk_size);
+    }
+    auto require(execution::bulk_dynamic_t p) const {
+      return _with_bulk_partition(_bulk_partition::dynamic_chunks, p.chunk_size);
+    }
+    auto require(execution::bulk_guided_t p) const {
+      return _with_bulk_partition(_bulk_partition::guided_chunks, p.chunk_size);
+    }
 
 };
 
@@ -82,7 +137,7 @@ class _static_thread_pool_executor {
 } // namespace detail
 
 static_thread_pool::static_thread_pool(size_t num_threads)
-  : pool_impl_(std::make_optional<detail::_thread_pool_t>(num_threads)),
+  : pool_impl_(std::in_place, num_threads),
     executors_done_promise_(
       new promise<void>(),
       [](auto* to_del) {
@@ -105,11 +160,16 @@ static_thread_pool::static_thread_pool(size_t num_threads)
 void
 static_thread_pool::attach() {
   assert(pool_impl_); // TODO throw
-  bool did_execute = true;
-  while(pool_impl_ and (!pool_impl_->closed() or did_execute)) {
-    did_execute = pool->try_executing_one();
-    pool = pool_impl_.get();
-  }
+  // spins for a while when there is no work, then parks until work is
+  // submitted; returns once the pool is closed and drained
+  pool_impl_->attach();
+}
+
+static_thread_pool::idle_statistics
+static_thread_pool::idle_stats() const noexcept {
+  if(not pool_impl_) return { };
+  auto stats = pool_impl_->idle_stats();
+  return { stats.spinning, stats.parked, stats.parks };
 }
 
 //void
@@ -136,11 +196,16 @@ static_thread_pool::attach() {
 
 void
 static_thread_pool::wait() {
+  // Drop our own reference to the promise, otherwise the trigger can't
+  // become ready while the pool is alive
+  executors_done_promise_ = nullptr;
   if(executors_done_trigger_.valid()) {
     executors_done_trigger_.get();
   }
+  if(not pool_impl_) return;
   pool_impl_->close();
-  pool_impl_ = nullptr;
+  // joins the workers once the pool is drained
+  pool_impl_.reset();
 
   // Don't allow any more submission to the underlying pool
   //detail::_thread_pool_t* expected = reinterpret_cast<detail::_thread_pool_t*>(reconstructing_pool_flag);
@@ -24,15 +24,16 @@ class _static_thread_pool_executor;
 #include <experimental/execution>
 
 #include <boost/thread/executor.hpp>
-#include <boost/thread/executors/thread_executor.hpp>
-#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <experimental/detail/work_stealing_pool.hpp>
 
 namespace std {
 namespace experimental {
 inline namespace executors_v1 {
 namespace detail {
 
-using _thread_pool_t = boost::basic_thread_pool;
+// Native work-stealing pool rather than boost::basic_thread_pool, whose single
+// shared queue serializes fine-grained borrow_async fan-out
+using _thread_pool_t = _work_stealing_pool;
 
 } // namespace detail
 } // inline namespace executors_v1
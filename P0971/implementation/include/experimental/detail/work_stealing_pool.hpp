@@ -0,0 +1,529 @@
+#ifndef ASYNC_PTR_EXPERIMENTAL_DETAIL_WORK_STEALING_POOL_HPP
+#define ASYNC_PTR_EXPERIMENTAL_DETAIL_WORK_STEALING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <experimental/detail/block_pool.hpp>
+
+namespace std {
+namespace experimental {
+inline namespace executors_v1 {
+namespace detail {
+
+//==============================================================================
+// type-erased unit of work, allocated from the block pools
+
+struct _work_stealing_task {
+  virtual void run() = 0;
+  virtual void destroy() noexcept = 0;
+  virtual ~_work_stealing_task() = default;
+};
+
+template <typename Closure>
+struct _work_stealing_task_impl final : _work_stealing_task {
+  Closure closure_;
+
+  template <typename C>
+  explicit _work_stealing_task_impl(C&& c) : closure_(std::forward<C>(c)) { }
+
+  void run() override { closure_(); }
+
+  void destroy() noexcept override { _pool_delete(this); }
+};
+
+//==============================================================================
+// Chase-Lev work-stealing deque
+//
+// The owning thread pushes and pops at the bottom (LIFO, so it runs the
+// task whose data is most likely still in its cache), any other thread
+// steals from the top (FIFO, so it takes the oldest and typically largest
+// piece of work). Memory orders follow Le, Pop, Cohen and Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+// Arrays replaced by a resize are kept until the deque is destroyed since a
+// thief may still be reading from them.
+
+template <typename T>
+class _chase_lev_deque {
+  private:
+
+    struct _array {
+      std::int64_t capacity_;
+      std::unique_ptr<std::atomic<T*>[]> slots_;
+
+      explicit _array(std::int64_t capacity)
+        : capacity_(capacity),
+          slots_(new std::atomic<T*>[capacity])
+      { }
+
+      T* get(std::int64_t i) const noexcept {
+        return slots_[i & (capacity_ - 1)].load(std::memory_order_relaxed);
+      }
+
+      void put(std::int64_t i, T* x) noexcept {
+        slots_[i & (capacity_ - 1)].store(x, std::memory_order_relaxed);
+      }
+    };
+
+    alignas(64) std::atomic<std::int64_t> top_ = { 0 };
+    alignas(64) std::atomic<std::int64_t> bottom_ = { 0 };
+    std::atomic<_array*> array_;
+    std::vector<std::unique_ptr<_array>> arrays_; // owner only
+
+    _array* _grow(_array* a, std::int64_t b, std::int64_t t) {
+      auto bigger = std::make_unique<_array>(a->capacity_ * 2);
+      for(std::int64_t i = t; i < b; ++i) bigger->put(i, a->get(i));
+      a = bigger.get();
+      arrays_.push_back(std::move(bigger));
+      array_.store(a, std::memory_order_release);
+      return a;
+    }
+
+  public:
+
+    // capacity must be a power of two
+    explicit _chase_lev_deque(std::int64_t capacity = 256) {
+      arrays_.push_back(std::make_unique<_array>(capacity));
+      array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    _chase_lev_deque(const _chase_lev_deque&) = delete;
+    _chase_lev_deque& operator=(const _chase_lev_deque&) = delete;
+
+    // owner only
+    void push(T* x) {
+      std::int64_t b = bottom_.load(std::memory_order_relaxed);
+      std::int64_t t = top_.load(std::memory_order_acquire);
+      _array* a = array_.load(std::memory_order_relaxed);
+      if(b - t > a->capacity_ - 1) a = _grow(a, b, t);
+      a->put(b, x);
+      std::atomic_thread_fence(std::memory_order_release);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // owner only; returns nullptr if the deque is empty
+    T* pop() noexcept {
+      std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+      _array* a = array_.load(std::memory_order_relaxed);
+      bottom_.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::int64_t t = top_.load(std::memory_order_relaxed);
+      T* x = nullptr;
+      if(t <= b) {
+        x = a->get(b);
+        if(t == b) {
+          // last element, race the thieves for it
+          if(not top_.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed)
+          ) {
+            x = nullptr;
+          }
+          bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+      }
+      else {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+      return x;
+    }
+
+    // any thread; returns nullptr if the deque is empty or another thread
+    // won the race for the top element
+    T* steal() noexcept {
+      std::int64_t t = top_.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::int64_t b = bottom_.load(std::memory_order_acquire);
+      if(t < b) {
+        _array* a = array_.load(std::memory_order_acquire);
+        T* x = a->get(t);
+        if(not top_.compare_exchange_strong(t, t + 1,
+          std::memory_order_seq_cst, std::memory_order_relaxed)
+        ) {
+          return nullptr;
+        }
+        return x;
+      }
+      return nullptr;
+    }
+
+    // approximate when called concurrently with push, pop or steal
+    bool empty() const noexcept {
+      return bottom_.load(std::memory_order_relaxed)
+        <= top_.load(std::memory_order_relaxed);
+    }
+};
+
+//==============================================================================
+// work-stealing thread pool
+//
+// Each worker owns a _chase_lev_deque. Work submitted from a worker (e.g.,
+// the continuations and nested borrows created by a running task) goes to
+// the bottom of that worker's own deque; work submitted from any other
+// thread goes to a shared injection queue. An idle worker pops its own
+// deque, then drains the injection queue, then steals from the top of the
+// other workers' deques, starting from a random victim. When that finds
+// nothing it keeps looking for a while (spinning) and then parks on a
+// condition variable until work is submitted. Threads attached with attach()
+// run the same loop without a deque of their own.
+//
+// The spin budget is adaptive, per thread: it doubles every time spinning
+// finds work (so a thread fed by a steady stream of short tasks never pays
+// for a park/wake round trip) and halves every time the thread has to park
+// anyway (so a thread on an idle pool stops burning its core quickly).
+// idle_statistics() reports how long the threads of the pool spent in each
+// state.
+//
+// Models the boost::thread Executor concept (submit, close, closed,
+// try_executing_one, reschedule_until), so it can be used with boost::async
+// and future::then like boost::basic_thread_pool. As with
+// basic_thread_pool, an exception escaping a task terminates the program.
+
+class _work_stealing_pool {
+  private:
+
+    using _task = _work_stealing_task;
+
+    struct alignas(64) _worker {
+      _chase_lev_deque<_task> deque_;
+      std::uint64_t rng_state_;
+    };
+
+    struct _thread_state {
+      _work_stealing_pool* pool_ = nullptr;
+      _worker* worker_ = nullptr;
+    };
+
+    static _thread_state& _this_thread() noexcept {
+      thread_local _thread_state state;
+      return state;
+    }
+
+    std::vector<std::unique_ptr<_worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex injection_mtx_;
+    std::deque<_task*> injection_queue_;
+
+    // tasks submitted but not yet popped or stolen
+    std::atomic<std::size_t> queued_ = { 0 };
+    // tasks submitted but not yet finished
+    std::atomic<std::size_t> pending_ = { 0 };
+    std::atomic<std::size_t> sleepers_ = { 0 };
+    std::atomic<bool> closed_ = { false };
+
+    std::mutex sleep_mtx_;
+    std::condition_variable sleep_cv_;
+    // threads inside attach(), guarded by sleep_mtx_
+    std::size_t attached_ = 0;
+
+    static constexpr unsigned min_spin_count = 16;
+    static constexpr unsigned max_spin_count = 1 << 14;
+    static constexpr unsigned initial_spin_count = 1 << 10;
+
+    std::atomic<std::int64_t> spinning_ns_ = { 0 };
+    std::atomic<std::int64_t> parked_ns_ = { 0 };
+    std::atomic<std::size_t> parks_ = { 0 };
+
+    static void _cpu_relax() noexcept {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+      __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+      asm volatile("yield");
+#endif
+    }
+
+    static std::uint64_t& _thread_rng_state() noexcept {
+      thread_local std::uint64_t rng_state = 0x2545F4914F6CDD1Dull
+        ^ std::uint64_t(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+      return rng_state;
+    }
+
+    static std::int64_t _ns_since(std::chrono::steady_clock::time_point start) noexcept {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start
+      ).count();
+    }
+
+    static std::uint64_t _next_random(std::uint64_t& state) noexcept {
+      // xorshift64
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return state;
+    }
+
+    void _wake_one() {
+      if(sleepers_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lg(sleep_mtx_);
+        sleep_cv_.notify_one();
+      }
+    }
+
+    void _wake_all() {
+      std::lock_guard<std::mutex> lg(sleep_mtx_);
+      sleep_cv_.notify_all();
+    }
+
+    void _enqueue(_task* task) {
+      pending_.fetch_add(1, std::memory_order_relaxed);
+      // count the task before publishing it, so that queued_ never drops
+      // below the number of tasks that can actually be found
+      queued_.fetch_add(1, std::memory_order_seq_cst);
+      auto& self = _this_thread();
+      if(self.pool_ == this and self.worker_) {
+        self.worker_->deque_.push(task);
+      }
+      else {
+        std::lock_guard<std::mutex> lg(injection_mtx_);
+        injection_queue_.push_back(task);
+      }
+      _wake_one();
+    }
+
+    _task* _pop_injected() {
+      std::lock_guard<std::mutex> lg(injection_mtx_);
+      if(injection_queue_.empty()) return nullptr;
+      _task* task = injection_queue_.front();
+      injection_queue_.pop_front();
+      return task;
+    }
+
+    _task* _steal(std::uint64_t& rng_state, _worker const* self) {
+      auto const n = workers_.size();
+      auto const start = std::size_t(_next_random(rng_state) % n);
+      for(std::size_t i = 0; i < n; ++i) {
+        _worker* victim = workers_[(start + i) % n].get();
+        if(victim == self) continue;
+        if(_task* task = victim->deque_.steal()) return task;
+      }
+      return nullptr;
+    }
+
+    _task* _find_task(_worker* self, std::uint64_t& rng_state) {
+      _task* task = nullptr;
+      if(self) task = self->deque_.pop();
+      if(not task) task = _pop_injected();
+      if(not task) task = _steal(rng_state, self);
+      if(task) queued_.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+
+    void _run(_task* task) {
+      task->run();
+      task->destroy();
+      if(pending_.fetch_sub(1, std::memory_order_acq_rel) == 1
+        and closed_.load(std::memory_order_acquire)
+      ) {
+        // the last piece of work is done; let the workers exit
+        _wake_all();
+      }
+    }
+
+    bool _done() const noexcept {
+      return closed_.load(std::memory_order_acquire)
+        and pending_.load(std::memory_order_acquire) == 0;
+    }
+
+    // Runs tasks until the pool is closed and all of its work has run.
+    void _run_until_done(_worker* self, std::uint64_t& rng_state) {
+      unsigned spin_count = initial_spin_count;
+      while(true) {
+        if(_task* task = _find_task(self, rng_state)) {
+          _run(task);
+          continue;
+        }
+
+        // spin
+        auto const spin_start = std::chrono::steady_clock::now();
+        _task* task = nullptr;
+        for(unsigned i = 0; i < spin_count and not task and not _done(); ++i) {
+          _cpu_relax();
+          // only touch the deques and the injection queue lock once
+          // something has been submitted
+          if(queued_.load(std::memory_order_relaxed) > 0) task = _find_task(self, rng_state);
+        }
+        spinning_ns_.fetch_add(_ns_since(spin_start), std::memory_order_relaxed);
+        if(task) {
+          spin_count = std::min(max_spin_count, spin_count * 2);
+          _run(task);
+          continue;
+        }
+        spin_count = std::max(min_spin_count, spin_count / 2);
+
+        // park until work is submitted or the pool is done
+        std::unique_lock<std::mutex> lk(sleep_mtx_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        if(queued_.load(std::memory_order_seq_cst) == 0 and not _done()) {
+          parks_.fetch_add(1, std::memory_order_relaxed);
+          auto const park_start = std::chrono::steady_clock::now();
+          sleep_cv_.wait(lk, [this]{
+            return queued_.load(std::memory_order_seq_cst) > 0 or _done();
+          });
+          parked_ns_.fetch_add(_ns_since(park_start), std::memory_order_relaxed);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        if(queued_.load(std::memory_order_relaxed) == 0 and _done()) break;
+      }
+    }
+
+    void _worker_loop(_worker* self) {
+      auto& state = _this_thread();
+      state.pool_ = this;
+      state.worker_ = self;
+      _run_until_done(self, self->rng_state_);
+      state = _thread_state{};
+    }
+
+  public:
+
+    explicit _work_stealing_pool(std::size_t num_threads) {
+      if(num_threads == 0) num_threads = 1;
+      workers_.reserve(num_threads);
+      for(std::size_t i = 0; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<_worker>());
+        workers_.back()->rng_state_ = 0x9E3779B97F4A7C15ull * (i + 1);
+      }
+      threads_.reserve(num_threads);
+      for(auto& w : workers_) {
+        threads_.emplace_back([this, w=w.get()]{ _worker_loop(w); });
+      }
+    }
+
+    _work_stealing_pool(const _work_stealing_pool&) = delete;
+    _work_stealing_pool& operator=(const _work_stealing_pool&) = delete;
+
+    // closes the pool and waits for all submitted work to finish
+    ~_work_stealing_pool() {
+      close();
+      join();
+    }
+
+    // Work submitted from inside the pool is accepted even after close(),
+    // since the pool drains it before the workers exit; work submitted from
+    // any other thread after close() throws std::logic_error. Submission
+    // from outside the pool must not race with close().
+    template <typename Closure>
+    void submit(Closure&& closure) {
+      auto& self = _this_thread();
+      if(closed_.load(std::memory_order_acquire) and self.pool_ != this) {
+        throw std::logic_error("submit on closed work-stealing pool");
+      }
+      _enqueue(_pool_new<_work_stealing_task_impl<std::decay_t<Closure>>>(
+        std::forward<Closure>(closure)
+      ));
+    }
+
+    // stop accepting work from outside the pool; workers exit once all
+    // submitted work has run
+    void close() {
+      {
+        std::lock_guard<std::mutex> lg(sleep_mtx_);
+        closed_.store(true, std::memory_order_release);
+      }
+      sleep_cv_.notify_all();
+    }
+
+    bool closed() const noexcept {
+      return closed_.load(std::memory_order_acquire);
+    }
+
+    // Waits for the workers and for the threads inside attach() to exit
+    // (except for the calling thread itself)
+    void join() {
+      for(auto& t : threads_) {
+        if(t.joinable() and t.get_id() != std::this_thread::get_id()) t.join();
+      }
+      if(_this_thread().pool_ != this) {
+        std::unique_lock<std::mutex> lk(sleep_mtx_);
+        sleep_cv_.wait(lk, [this]{ return attached_ == 0; });
+      }
+    }
+
+    // Runs tasks on the calling thread, like a worker, until the pool is
+    // closed and all of its work has run.
+    void attach() {
+      {
+        std::lock_guard<std::mutex> lg(sleep_mtx_);
+        ++attached_;
+      }
+      auto& state = _this_thread();
+      auto const saved = state;
+      state.pool_ = this;
+      state.worker_ = nullptr;
+      _run_until_done(nullptr, _thread_rng_state());
+      state = saved;
+      // last access to the pool, which join() (and so the destructor) may
+      // free as soon as the lock is released
+      std::lock_guard<std::mutex> lg(sleep_mtx_);
+      if(--attached_ == 0) sleep_cv_.notify_all();
+    }
+
+    // Runs one task on the calling thread, if one is available. Used to
+    // make progress while blocked (reschedule_until, bulk_execute).
+    bool try_executing_one() {
+      auto& state = _this_thread();
+      _worker* self = state.pool_ == this ? state.worker_ : nullptr;
+      _task* task = _find_task(self, self ? self->rng_state_ : _thread_rng_state());
+      if(not task) return false;
+      // a task run here on a thread of another pool (or a foreign thread)
+      // must not push its own submissions onto that thread's deque
+      auto const saved = state;
+      state.pool_ = this;
+      state.worker_ = self;
+      _run(task);
+      state = saved;
+      return true;
+    }
+
+    template <typename Pred>
+    bool reschedule_until(Pred const& pred) {
+      do {
+        if(not try_executing_one()) return false;
+      } while(not pred());
+      return true;
+    }
+
+    std::size_t num_threads() const noexcept { return workers_.size(); }
+
+    // true on the workers, on attached threads and while running a task
+    // through try_executing_one()
+    bool running_in_this_thread() const noexcept {
+      return _this_thread().pool_ == this;
+    }
+
+    struct idle_statistics {
+      // total over all threads of the pool, workers and attached threads
+      std::chrono::nanoseconds spinning;
+      std::chrono::nanoseconds parked;
+      // number of times a thread parked
+      std::size_t parks;
+    };
+
+    idle_statistics idle_stats() const noexcept {
+      return {
+        std::chrono::nanoseconds(spinning_ns_.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(parked_ns_.load(std::memory_order_relaxed)),
+        parks_.load(std::memory_order_relaxed)
+      };
+    }
+};
+
+} // namespace detail
+} // inline namespace executors_v1
+} // namespace experimental
+} // namespace std
+
+#endif // ASYNC_PTR_EXPERIMENTAL_DETAIL_WORK_STEALING_POOL_HPP